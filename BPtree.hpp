@@ -0,0 +1,1165 @@
+#pragma once
+#include <iostream>
+#include <new>
+#include "utils/utils.hpp"
+#include "vector.hpp"
+
+namespace ft {
+	struct BPnode {
+		bool		is_leaf;
+		unsigned	count;
+
+		BPnode(bool leaf) : is_leaf(leaf), count(0) {}
+	};
+
+	//les valeurs sont stockees dans les feuilles, chainees dans les deux sens
+	template <class V, std::size_t Cap>
+	struct BPleaf : BPnode {
+		BPleaf*					prev;
+		BPleaf*					next;
+		alignas(V) unsigned char	raw[sizeof(V) * Cap];
+
+		BPleaf() : BPnode(true), prev(0), next(0) {}
+
+		V* slots() { return reinterpret_cast<V*>(raw); }
+	};
+
+	//les cles de separation sont contigues : keys[i] <= tout element de children[i + 1]
+	template <class Key, std::size_t Cap>
+	struct BPinner : BPnode {
+		alignas(Key) unsigned char	raw[sizeof(Key) * Cap];
+		BPnode*						children[Cap + 1];
+
+		BPinner() : BPnode(false) {}
+
+		Key* keys() { return reinterpret_cast<Key*>(raw); }
+	};
+
+	template <class T, class Leaf>
+	class bptree_iterator : public iterator<std::bidirectional_iterator_tag, T> {
+		public:
+			typedef	T								value_type;
+			typedef	T*								pointer;
+			typedef T&								reference;
+
+			bptree_iterator() : leaf(0), idx(0) {}
+			bptree_iterator(Leaf* _leaf, unsigned _idx) : leaf(_leaf), idx(_idx) {}
+			template <class U>
+			bptree_iterator(const bptree_iterator<U, Leaf>& x) : leaf(x.as_leaf()), idx(x.index()) {}
+
+			reference operator*() const { return leaf->slots()[idx]; }
+
+			pointer operator->() const { return &(leaf->slots()[idx]); }
+
+			Leaf* as_leaf() const { return leaf; }
+			unsigned index() const { return idx; }
+
+			bptree_iterator& operator++() {
+				if (++idx == leaf->count && leaf->next)
+				{
+					leaf = leaf->next;
+					idx = 0;
+				}
+				return *this;
+			}
+
+			bptree_iterator operator++(int) {
+				bptree_iterator ret(*this);
+				++(*this);
+				return ret;
+			}
+
+			bptree_iterator& operator--() {
+				if (idx == 0)
+				{
+					leaf = leaf->prev;
+					idx = leaf->count;
+				}
+				idx--;
+				return *this;
+			}
+
+			bptree_iterator operator--(int) {
+				bptree_iterator ret(*this);
+				--(*this);
+				return ret;
+			}
+
+			template <class U>
+			bool operator==(const bptree_iterator<U, Leaf>& y) const { return leaf == y.as_leaf() && idx == y.index(); }
+			template <class U>
+			bool operator!=(const bptree_iterator<U, Leaf>& y) const { return !(*this == y); }
+		private:
+			Leaf*		leaf;
+			unsigned	idx;
+	};
+
+	// B+ tree keyed on V::first. Nodes are about NodeBytes wide: leaves hold the
+	// values themselves, inner nodes only keys and child pointers, so a lookup
+	// touches a handful of contiguous cache lines per level.
+	// Iterators are invalidated by any insertion or erasure. Values are shifted
+	// inside their leaf by copy, so a value whose copy throws may leave the tree
+	// in an unspecified state during insert / erase; copies and bulk builds are safe.
+	template <	class Key,
+				class V,
+				class Compare = std::less<Key>,
+				class Alloc = std::allocator<V>,
+				std::size_t NodeBytes = 256 >
+	class BPtree {
+		public:
+			static const std::size_t	leaf_cap = (NodeBytes / sizeof(V) > 4) ? NodeBytes / sizeof(V) : 4;
+			static const std::size_t	inner_cap = (NodeBytes / (sizeof(Key) + sizeof(void*)) > 4) ? NodeBytes / (sizeof(Key) + sizeof(void*)) : 4;
+
+			typedef	Key														key_type;
+			typedef	V														value_type;
+			typedef	Compare													key_compare;
+			typedef	Alloc													alloc_type;
+			typedef	BPleaf<V, leaf_cap>										leaf_type;
+			typedef	BPinner<Key, inner_cap>									inner_type;
+			typedef	typename Alloc::template rebind<leaf_type>::other		leaf_alloc_type;
+			typedef	typename Alloc::template rebind<inner_type>::other		inner_alloc_type;
+			typedef	typename Alloc::template rebind<BPnode*>::other			level_alloc_type;
+
+			typedef bptree_iterator<value_type, leaf_type>					iterator;
+			typedef bptree_iterator<const value_type, leaf_type>			const_iterator;
+			typedef ft::reverse_iterator<iterator>							reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+
+			typedef	ptrdiff_t												difference_type;
+			typedef	std::size_t												size_type;
+
+			explicit BPtree(const Compare& _comp = Compare())
+				:	comp(_comp),
+					_size(0) {
+						root = head = tail = new_leaf();
+					}
+
+			BPtree(const BPtree& x)
+				:	comp(x.comp),
+					alloc(x.alloc),
+					_size(0) {
+						root = head = tail = new_leaf();
+						try
+						{
+							copy_from(x);
+						}
+						catch (...)
+						{
+							help_clear(root);
+							throw;
+						}
+					}
+
+			~BPtree() {
+				help_clear(root);
+			}
+
+			BPtree& operator=(const BPtree& x) {
+				if (this == &x)
+					return *this;
+				clear();
+				comp = x.comp;
+				copy_from(x);
+				return *this;
+			}
+
+			void clear() {
+				help_clear(root);
+				_size = 0;
+				root = head = tail = new_leaf();
+			}
+
+			iterator begin() { return iterator(head, 0); }
+			iterator end() { return iterator(tail, tail->count); }
+			const_iterator begin() const { return const_iterator(head, 0); }
+			const_iterator end() const { return const_iterator(tail, tail->count); }
+
+			size_type size() const { return _size; }
+
+			//cherche les cles de [first, last) par paquets : toutes les feuilles sont a la
+			//meme profondeur, les descentes avancent donc d'un niveau ensemble et chaque
+			//noeud suivant est precharge pendant que les autres recherches progressent.
+			//*out++ recoit un iterateur par cle, dans l'ordre, end() si la cle est absente
+			template <class ForwardIterator, class OutputIterator, class C>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out, C c) {
+				return help_find_batch<iterator>(first, last, out, c);
+			}
+
+			template <class ForwardIterator, class OutputIterator, class C>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out, C c) const {
+				return help_find_batch<const_iterator>(first, last, out, c);
+			}
+
+			//appelle f sur chaque element dans l'ordre en suivant la liste des feuilles,
+			//la suivante prechargee pendant le parcours de la courante.
+			//f ne doit ni inserer ni supprimer
+			template <class F>
+			void for_each(F& f) {
+				walk<value_type&>(head, 0, f, no_bound());
+			}
+
+			template <class F>
+			void for_each(F& f) const {
+				walk<const value_type&>(head, 0, f, no_bound());
+			}
+
+			//meme chose pour les elements de [lo, hi)
+			template <class K, class C, class F>
+			void for_each_range(const K& lo, const K& hi, C c, F& f) {
+				(void)c;
+				leaf_type* leaf = find_leaf(lo);
+				walk<value_type&>(leaf, leaf_lower(leaf, lo), f, below<K>(hi, comp));
+			}
+
+			template <class K, class C, class F>
+			void for_each_range(const K& lo, const K& hi, C c, F& f) const {
+				(void)c;
+				leaf_type* leaf = find_leaf(lo);
+				walk<const value_type&>(leaf, leaf_lower(leaf, lo), f, below<K>(hi, comp));
+			}
+
+			//les noeuds internes ne comptent pas leurs elements : rang et k-ieme
+			//element sautent les feuilles entieres, en O(n / leaf_cap)
+			iterator nth(size_type k) {
+				leaf_type* leaf = nth_leaf(k);
+				return k < leaf->count ? iterator(leaf, k) : end();
+			}
+
+			const_iterator nth(size_type k) const {
+				leaf_type* leaf = nth_leaf(k);
+				return k < leaf->count ? const_iterator(leaf, k) : end();
+			}
+
+			template <class K, class C>
+			size_type rank(const K& k, C c) const {
+				return index_of(lower_bound(k, c));
+			}
+
+			size_type index_of(const_iterator it) const {
+				size_type ret = it.index();
+				for (leaf_type* leaf = head; leaf != it.as_leaf(); leaf = leaf->next)
+					ret += leaf->count;
+				return ret;
+			}
+
+			size_type max_size() const { return alloc.max_size(); }
+
+			ft::pair<iterator,bool> insert(const value_type& val) {
+				const Key&	k = val.first;
+
+				if (root->count == (root->is_leaf ? leaf_cap : inner_cap))
+				{
+					inner_type* r = new_inner();
+					r->children[0] = root;
+					try
+					{
+						split_child(r, 0);
+					}
+					catch (...)
+					{
+						free_inner(r);
+						throw;
+					}
+					root = r;
+				}
+				BPnode* n = root;
+				while (!n->is_leaf)
+				{
+					inner_type*	in = static_cast<inner_type*>(n);
+					unsigned	i = child_index(in, k);
+					BPnode*		c = in->children[i];
+					if (c->count == (c->is_leaf ? leaf_cap : inner_cap))
+					{
+						split_child(in, i);
+						if (!comp(k, in->keys()[i]))
+							i++;
+						c = in->children[i];
+					}
+					n = c;
+				}
+				leaf_type*	leaf = static_cast<leaf_type*>(n);
+				unsigned	i = leaf_lower(leaf, k);
+				if (i < leaf->count && !comp(k, leaf->slots()[i].first))
+					return ft::make_pair<iterator, bool> (iterator(leaf, i), false);
+				for (unsigned j = leaf->count; j > i; j--)
+					move_slot(leaf->slots() + j, leaf->slots() + j - 1);
+				try
+				{
+					alloc.construct(leaf->slots() + i, val);
+				}
+				catch (...)
+				{
+					for (unsigned j = i; j < leaf->count; j++)
+						move_slot(leaf->slots() + j, leaf->slots() + j + 1);
+					throw;
+				}
+				leaf->count++;
+				_size++;
+				return ft::make_pair<iterator, bool> (iterator(leaf, i), true);
+			}
+
+			//la descente est deja courte, l'indice n'est pas utilise
+			iterator insert(iterator hint, const value_type& val) {
+				(void)hint;
+				return insert(val).first;
+			}
+
+			template <class InputIterator>
+			bool is_sorted_unique(InputIterator first, InputIterator last) const {
+				if (first == last)
+					return true;
+				InputIterator prev = first;
+				while (++first != last)
+				{
+					if (!comp((*prev).first, (*first).first))
+						return false;
+					prev = first;
+				}
+				return true;
+			}
+
+			//remplit les feuilles de gauche a droite puis construit les niveaux internes
+			//l'arbre doit etre vide
+			template <class InputIterator>
+			void build_sorted(InputIterator first, InputIterator last) {
+				help_build_sorted(first, last, std::integral_constant<bool, ft::is_multipass_iterator<InputIterator>::value>());
+			}
+
+			iterator erase(iterator position) {
+				Key k(position->first);
+				erase(k, 0);
+				return lower_bound(k, 0);
+			}
+
+			void erase(iterator first, iterator last) {
+				size_type n = 0;
+				for (iterator it = first; it != last; it++)
+					n++;
+				while (n--)
+					first = erase(first);
+			}
+
+			//c n'est utile qu'aux arbres qui comparent des valeurs entieres a chaque niveau :
+			//ici les noeuds internes ne contiennent que des cles, comparees par comp
+			template <class K, class C>
+			size_type erase(const K& k, C c) {
+				(void)c;
+				BPnode* n = root;
+				while (!n->is_leaf)
+				{
+					inner_type*	in = static_cast<inner_type*>(n);
+					unsigned	i = child_index(in, k);
+					i = fix_child(in, i);
+					n = in->children[i];
+					if (in == root && in->count == 0)
+					{
+						root = n;
+						free_inner(in);
+					}
+				}
+				leaf_type*	leaf = static_cast<leaf_type*>(n);
+				unsigned	i = leaf_lower(leaf, k);
+				if (i == leaf->count || comp(k, leaf->slots()[i].first))
+					return 0;
+				alloc.destroy(leaf->slots() + i);
+				for (unsigned j = i + 1; j < leaf->count; j++)
+					move_slot(leaf->slots() + j - 1, leaf->slots() + j);
+				leaf->count--;
+				_size--;
+				return 1;
+			}
+
+			template <class K, class C>
+			iterator find(const K& k, C c) {
+				iterator it = lower_bound(k, c);
+				if (it == end() || comp(k, it->first))
+					return end();
+				return it;
+			}
+
+			template <class K, class C>
+			const_iterator find(const K& k, C c) const {
+				const_iterator it = lower_bound(k, c);
+				if (it == end() || comp(k, it->first))
+					return end();
+				return it;
+			}
+
+			template <class K, class C>
+			iterator lower_bound(const K& k, C c) {
+				(void)c;
+				leaf_type* leaf = find_leaf(k);
+				return normalize(leaf, leaf_lower(leaf, k));
+			}
+
+			template <class K, class C>
+			const_iterator lower_bound(const K& k, C c) const {
+				(void)c;
+				leaf_type* leaf = find_leaf(k);
+				return normalize(leaf, leaf_lower(leaf, k));
+			}
+
+			template <class K, class C>
+			iterator upper_bound(const K& k, C c) {
+				(void)c;
+				leaf_type* leaf = find_leaf(k);
+				return normalize(leaf, leaf_upper(leaf, k));
+			}
+
+			template <class K, class C>
+			const_iterator upper_bound(const K& k, C c) const {
+				(void)c;
+				leaf_type* leaf = find_leaf(k);
+				return normalize(leaf, leaf_upper(leaf, k));
+			}
+
+			//le B+ arbre n'a pas de join : ces operations recopient les elements
+			//concernes et reconstruisent les arbres en O(n + m)
+
+			//ajoute les elements de x, tous superieurs a ceux de l'arbre ; x est vide ensuite
+			void join(BPtree& x) {
+				if (this == &x || !x._size)
+					return ;
+				ft::vector<value_type> all(begin(), end());
+				for (iterator it = x.begin(); it != x.end(); it++)
+					all.push_back(*it);
+				rebuild(all);
+				x.clear();
+			}
+
+			//deplace dans out les elements non inferieurs a k, out perd son contenu
+			template <class K, class C>
+			void split(const K& k, C c, BPtree& out) {
+				iterator				mid = lower_bound(k, c);
+				ft::vector<value_type>	low(begin(), mid);
+				ft::vector<value_type>	high(mid, end());
+
+				rebuild(low);
+				out.rebuild(high);
+			}
+
+			//deplace dans out les elements de [lo, hi), out perd son contenu
+			template <class K, class C>
+			void extract_range(const K& lo, const K& hi, C c, BPtree& out) {
+				iterator				first = lower_bound(lo, c);
+				iterator				last = lower_bound(hi, c);
+				if (index_of(last) < index_of(first))
+					last = first;
+				ft::vector<value_type>	keep(begin(), first);
+				ft::vector<value_type>	range(first, last);
+
+				for (; last != end(); last++)
+					keep.push_back(*last);
+				rebuild(keep);
+				out.rebuild(range);
+			}
+
+			//union : prend les elements de x absents de l'arbre, x garde les autres
+			void merge(BPtree& x) {
+				if (this == &x || !x._size)
+					return ;
+				ft::vector<value_type>	all;
+				ft::vector<value_type>	dup;
+				iterator				i = begin();
+				iterator				j = x.begin();
+
+				while (i != end() || j != x.end())
+				{
+					if (j == x.end() || (i != end() && comp(i->first, j->first)))
+						all.push_back(*i++);
+					else if (i == end() || comp(j->first, i->first))
+						all.push_back(*j++);
+					else
+					{
+						all.push_back(*i++);
+						dup.push_back(*j++);
+					}
+				}
+				rebuild(all);
+				x.rebuild(dup);
+			}
+
+			//intersection : ne garde que les elements presents dans x
+			void intersect(const BPtree& x) {
+				if (this != &x)
+					filter(x, true);
+			}
+
+			//difference : retire les elements presents dans x
+			void subtract(const BPtree& x) {
+				if (this == &x)
+					clear();
+				else
+					filter(x, false);
+			}
+
+			void swap(BPtree& x) {
+				BPnode*		root_tmp = root;
+				leaf_type*	head_tmp = head;
+				leaf_type*	tail_tmp = tail;
+				size_type	size_tmp = _size;
+				Compare		comp_tmp = comp;
+				//les noeuds restent attaches a l'allocateur qui les a fournis
+				leaf_alloc_type		leaf_alloc_tmp = leaf_alloc;
+				inner_alloc_type	inner_alloc_tmp = inner_alloc;
+				root = x.root;
+				head = x.head;
+				tail = x.tail;
+				_size = x._size;
+				comp = x.comp;
+				x.root = root_tmp;
+				x.head = head_tmp;
+				x.tail = tail_tmp;
+				x._size = size_tmp;
+				x.comp = comp_tmp;
+				leaf_alloc = x.leaf_alloc;
+				x.leaf_alloc = leaf_alloc_tmp;
+				inner_alloc = x.inner_alloc;
+				x.inner_alloc = inner_alloc_tmp;
+			}
+
+		private:
+			//la repartition en feuilles demande n avant de lire : une entree a passage
+			//unique est d'abord recopiee
+			template <class InputIterator>
+			void help_build_sorted(InputIterator first, InputIterator last, std::false_type) {
+				ft::vector<value_type>	staged;
+				for (; first != last; ++first)
+					staged.push_back(*first);
+				help_build_sorted(staged.begin(), staged.end(), std::true_type());
+			}
+
+			template <class ForwardIterator>
+			void help_build_sorted(ForwardIterator first, ForwardIterator last, std::true_type) {
+				size_type n = 0;
+				for (ForwardIterator it = first; it != last; it++)
+					n++;
+				if (n == 0)
+					return ;
+				size_type	count = (n + leaf_cap - 1) / leaf_cap;
+				size_type	width = count;
+				level_alloc_type	level_alloc(alloc);
+				BPnode**	level = level_alloc.allocate(width);
+				std::fill(level, level + count, static_cast<BPnode*>(0));
+				inner_type*	pending = 0;
+				size_type	pending_take = 0;
+				size_type	parents = 0;
+				size_type	pos = 0;
+				help_clear(root);
+				root = head = tail = 0;
+				try
+				{
+					for (size_type l = 0; l < count; l++)
+					{
+						leaf_type* leaf = new_leaf();
+						level[l] = leaf;
+						leaf->prev = tail;
+						if (tail)
+							tail->next = leaf;
+						else
+							head = leaf;
+						tail = leaf;
+						size_type take = n / count + (l < n % count);
+						for (size_type j = 0; j < take; j++, first++)
+						{
+							alloc.construct(leaf->slots() + j, *first);
+							leaf->count++;
+						}
+					}
+					while (count > 1)
+					{
+						size_type total = (count + inner_cap) / (inner_cap + 1);
+						pos = 0;
+						for (parents = 0; parents < total; parents++)
+						{
+							pending = new_inner();
+							pending_take = count / total + (parents < count % total);
+							for (size_type j = 0; j < pending_take; j++)
+								pending->children[j] = level[pos + j];
+							pos += pending_take;
+							for (size_type j = 1; j < pending_take; j++)
+							{
+								new (pending->keys() + j - 1) Key(min_key(pending->children[j]));
+								pending->count++;
+							}
+							level[parents] = pending;
+							pending = 0;
+						}
+						count = total;
+						parents = 0;
+						pos = 0;
+					}
+				}
+				catch (...)
+				{
+					//les feuilles sont retrouvees par le chainage, seuls les noeuds internes sont suivis ici
+					if (pending)
+					{
+						for (size_type j = 0; j < pending_take; j++)
+							free_inners(pending->children[j]);
+						free_inner(pending);
+					}
+					for (size_type l = 0; l < parents; l++)
+						free_inners(level[l]);
+					for (size_type l = pos; l < count; l++)
+						free_inners(level[l]);
+					level_alloc.deallocate(level, width);
+					free_partial();
+					throw;
+				}
+				root = level[0];
+				level_alloc.deallocate(level, width);
+				_size = n;
+			}
+
+			BPnode*				root;
+			leaf_type*			head;
+			leaf_type*			tail;
+			Compare				comp;
+			Alloc				alloc;
+			leaf_alloc_type		leaf_alloc;
+			inner_alloc_type	inner_alloc;
+			size_type			_size;
+
+			leaf_type* new_leaf() {
+				leaf_type* leaf = leaf_alloc.allocate(1);
+				new (leaf) leaf_type();
+				return leaf;
+			}
+
+			inner_type* new_inner() {
+				inner_type* in = inner_alloc.allocate(1);
+				new (in) inner_type();
+				return in;
+			}
+
+			void free_leaf(leaf_type* leaf) {
+				for (unsigned i = 0; i < leaf->count; i++)
+					alloc.destroy(leaf->slots() + i);
+				leaf_alloc.deallocate(leaf, 1);
+			}
+
+			void free_inner(inner_type* in) {
+				for (unsigned i = 0; i < in->count; i++)
+					in->keys()[i].~Key();
+				inner_alloc.deallocate(in, 1);
+			}
+
+			void help_clear(BPnode* n) {
+				if (!n)
+					return ;
+				if (n->is_leaf)
+				{
+					free_leaf(static_cast<leaf_type*>(n));
+					return ;
+				}
+				inner_type* in = static_cast<inner_type*>(n);
+				for (unsigned i = 0; i <= in->count; i++)
+					help_clear(in->children[i]);
+				free_inner(in);
+			}
+
+			//libere les noeuds internes d'un sous-arbre en laissant les feuilles a free_partial
+			void free_inners(BPnode* n) {
+				if (!n || n->is_leaf)
+					return ;
+				inner_type* in = static_cast<inner_type*>(n);
+				for (unsigned i = 0; i <= in->count; i++)
+					free_inners(in->children[i]);
+				free_inner(in);
+			}
+
+			//construction interrompue : les feuilles deja creees sont toutes chainees depuis head
+			void free_partial() {
+				leaf_type* leaf = head;
+				while (leaf)
+				{
+					leaf_type* next = leaf->next;
+					free_leaf(leaf);
+					leaf = next;
+				}
+				root = head = tail = new_leaf();
+				_size = 0;
+			}
+
+			//deplace le contenu de src (construit) vers dst (brut)
+			void move_slot(V* dst, V* src) {
+				alloc.construct(dst, *src);
+				alloc.destroy(src);
+			}
+
+			void set_key(inner_type* in, unsigned i, const Key& k) {
+				in->keys()[i].~Key();
+				new (in->keys() + i) Key(k);
+			}
+
+			static const Key& min_key(BPnode* n) {
+				while (!n->is_leaf)
+					n = static_cast<inner_type*>(n)->children[0];
+				return static_cast<leaf_type*>(n)->slots()[0].first;
+			}
+
+			static const unsigned	batch_lanes = 8;
+
+			//tout le noeud, pas seulement l'en-tete : la recherche binaire en lit plusieurs lignes
+			static void prefetch_node(const BPnode* n) {
+				const char* p = reinterpret_cast<const char*>(n);
+				for (std::size_t off = 0; off < NodeBytes; off += 64)
+					ft::prefetch(p + off);
+			}
+
+			//bornes de for_each_range ; no_bound laisse tout passer
+			struct no_bound {
+				bool operator()(const value_type&) const { return true; }
+			};
+
+			template <class K>
+			struct below {
+				const K&	hi;
+				Compare		comp;
+				below(const K& _hi, Compare _comp) : hi(_hi), comp(_comp) {}
+				bool operator()(const value_type& x) const { return comp(x.first, hi); }
+			};
+
+			//parcourt les feuilles a partir de la position i de leaf ;
+			//s'arrete au premier element refuse par bound
+			template <class Ref, class F, class Bound>
+			static void walk(leaf_type* leaf, unsigned i, F& f, Bound bound) {
+				for (; leaf; leaf = leaf->next, i = 0)
+				{
+					if (leaf->next)
+						prefetch_node(leaf->next);
+					for (; i < leaf->count; i++)
+					{
+						if (!bound(leaf->slots()[i]))
+							return ;
+						f(static_cast<Ref>(leaf->slots()[i]));
+					}
+				}
+			}
+
+			template <class It, class ForwardIterator, class OutputIterator, class C>
+			OutputIterator help_find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out, C c) const {
+				ForwardIterator	keys[batch_lanes];
+				BPnode*			cur[batch_lanes];
+
+				(void)c;
+				while (first != last)
+				{
+					unsigned n = 0;
+					for (; n < batch_lanes && first != last; ++n, ++first)
+					{
+						keys[n] = first;
+						cur[n] = root;
+					}
+					while (!cur[0]->is_leaf)
+					{
+						for (unsigned i = 0; i < n; i++)
+						{
+							inner_type* in = static_cast<inner_type*>(cur[i]);
+							cur[i] = in->children[child_index(in, *keys[i])];
+							prefetch_node(cur[i]);
+						}
+					}
+					for (unsigned i = 0; i < n; i++)
+					{
+						leaf_type*	leaf = static_cast<leaf_type*>(cur[i]);
+						unsigned	j = leaf_lower(leaf, *keys[i]);
+						if (j < leaf->count && !comp(*keys[i], leaf->slots()[j].first))
+							*out++ = It(leaf, j);
+						else
+							*out++ = It(tail, tail->count);
+					}
+				}
+				return out;
+			}
+
+			void rebuild(const ft::vector<value_type>& v) {
+				clear();
+				build_sorted(v.begin(), v.end());
+			}
+
+			//garde les elements dont la presence dans x vaut in_x
+			void filter(const BPtree& x, bool in_x) {
+				ft::vector<value_type>	keep;
+				iterator				i = begin();
+				const_iterator			j = x.begin();
+
+				for (; i != end(); i++)
+				{
+					while (j != x.end() && comp(j->first, i->first))
+						j++;
+					bool found = (j != x.end() && !comp(i->first, j->first));
+					if (found == in_x)
+						keep.push_back(*i);
+				}
+				rebuild(keep);
+			}
+
+			//feuille du k-ieme element, k devenant son indice dans la feuille
+			leaf_type* nth_leaf(size_type& k) const {
+				leaf_type* leaf = head;
+				while (k >= leaf->count && leaf->next)
+				{
+					k -= leaf->count;
+					leaf = leaf->next;
+				}
+				return leaf;
+			}
+
+			//indice du premier separateur strictement superieur a k
+			template <class K>
+			unsigned child_index(inner_type* in, const K& k) const {
+				unsigned lo = 0;
+				unsigned len = in->count;
+				while (len)
+				{
+					unsigned half = len / 2;
+					if (!comp(k, in->keys()[lo + half]))
+					{
+						lo += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return lo;
+			}
+
+			template <class K>
+			unsigned leaf_lower(leaf_type* leaf, const K& k) const {
+				unsigned lo = 0;
+				unsigned len = leaf->count;
+				while (len)
+				{
+					unsigned half = len / 2;
+					if (comp(leaf->slots()[lo + half].first, k))
+					{
+						lo += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return lo;
+			}
+
+			template <class K>
+			unsigned leaf_upper(leaf_type* leaf, const K& k) const {
+				unsigned lo = 0;
+				unsigned len = leaf->count;
+				while (len)
+				{
+					unsigned half = len / 2;
+					if (!comp(k, leaf->slots()[lo + half].first))
+					{
+						lo += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return lo;
+			}
+
+			template <class K>
+			leaf_type* find_leaf(const K& k) const {
+				BPnode* n = root;
+				while (!n->is_leaf)
+				{
+					inner_type* in = static_cast<inner_type*>(n);
+					n = in->children[child_index(in, k)];
+				}
+				return static_cast<leaf_type*>(n);
+			}
+
+			//une position en fin de feuille designe le premier element de la suivante
+			iterator normalize(leaf_type* leaf, unsigned i) const {
+				if (i == leaf->count && leaf->next)
+					return iterator(leaf->next, 0);
+				return iterator(leaf, i);
+			}
+
+			//coupe l'enfant plein i de parent en deux, parent n'est pas plein
+			void split_child(inner_type* parent, unsigned i) {
+				BPnode* c = parent->children[i];
+				BPnode* right;
+
+				if (c->is_leaf)
+				{
+					leaf_type*	l = static_cast<leaf_type*>(c);
+					leaf_type*	r = new_leaf();
+					unsigned	h = l->count / 2;
+					//copie d'abord, l reste intact si une copie echoue
+					try
+					{
+						for (unsigned j = h; j < l->count; j++, r->count++)
+							alloc.construct(r->slots() + j - h, l->slots()[j]);
+					}
+					catch (...)
+					{
+						free_leaf(r);
+						throw;
+					}
+					for (unsigned j = h; j < l->count; j++)
+						alloc.destroy(l->slots() + j);
+					l->count = h;
+					r->next = l->next;
+					r->prev = l;
+					if (l->next)
+						l->next->prev = r;
+					else
+						tail = r;
+					l->next = r;
+					right = r;
+				}
+				else
+				{
+					inner_type*	l = static_cast<inner_type*>(c);
+					inner_type*	r = new_inner();
+					unsigned	mid = l->count / 2;
+					for (unsigned j = mid + 1; j < l->count; j++)
+					{
+						new (r->keys() + j - mid - 1) Key(l->keys()[j]);
+						l->keys()[j].~Key();
+					}
+					for (unsigned j = mid + 1; j <= l->count; j++)
+						r->children[j - mid - 1] = l->children[j];
+					r->count = l->count - mid - 1;
+					right = r;
+				}
+				for (unsigned j = parent->count; j > i; j--)
+				{
+					new (parent->keys() + j) Key(parent->keys()[j - 1]);
+					parent->keys()[j - 1].~Key();
+					parent->children[j + 1] = parent->children[j];
+				}
+				if (c->is_leaf)
+					new (parent->keys() + i) Key(static_cast<leaf_type*>(right)->slots()[0].first);
+				else
+				{
+					inner_type*	l = static_cast<inner_type*>(c);
+					unsigned	mid = l->count / 2;
+					new (parent->keys() + i) Key(l->keys()[mid]);
+					l->keys()[mid].~Key();
+					l->count = mid;
+				}
+				parent->children[i + 1] = right;
+				parent->count++;
+			}
+
+			//retire le separateur i et l'enfant i + 1 de in
+			void remove_entry(inner_type* in, unsigned i) {
+				in->keys()[i].~Key();
+				for (unsigned j = i + 1; j < in->count; j++)
+				{
+					new (in->keys() + j - 1) Key(in->keys()[j]);
+					in->keys()[j].~Key();
+				}
+				for (unsigned j = i + 1; j < in->count; j++)
+					in->children[j] = in->children[j + 1];
+				in->count--;
+			}
+
+			//avant de descendre dans l'enfant i, s'assure qu'il peut perdre un element
+			//en empruntant a un voisin ou en fusionnant ; retourne l'indice de l'enfant a suivre
+			unsigned fix_child(inner_type* in, unsigned i) {
+				BPnode*		c = in->children[i];
+				unsigned	min = c->is_leaf ? leaf_cap / 2 : (inner_cap - 1) / 2;
+
+				if (c->count > min)
+					return i;
+				BPnode*	left = i > 0 ? in->children[i - 1] : 0;
+				BPnode*	right = i < in->count ? in->children[i + 1] : 0;
+				if (left && left->count > min)
+					borrow_left(in, i);
+				else if (right && right->count > min)
+					borrow_right(in, i);
+				else if (right)
+					merge(in, i);
+				else
+				{
+					merge(in, i - 1);
+					i--;
+				}
+				return i;
+			}
+
+			void borrow_left(inner_type* in, unsigned i) {
+				BPnode* c = in->children[i];
+				BPnode* left = in->children[i - 1];
+
+				if (c->is_leaf)
+				{
+					leaf_type* l = static_cast<leaf_type*>(left);
+					leaf_type* n = static_cast<leaf_type*>(c);
+					for (unsigned j = n->count; j > 0; j--)
+						move_slot(n->slots() + j, n->slots() + j - 1);
+					move_slot(n->slots(), l->slots() + l->count - 1);
+					l->count--;
+					n->count++;
+					set_key(in, i - 1, n->slots()[0].first);
+				}
+				else
+				{
+					inner_type* l = static_cast<inner_type*>(left);
+					inner_type* n = static_cast<inner_type*>(c);
+					for (unsigned j = n->count; j > 0; j--)
+					{
+						new (n->keys() + j) Key(n->keys()[j - 1]);
+						n->keys()[j - 1].~Key();
+					}
+					for (unsigned j = n->count + 1; j > 0; j--)
+						n->children[j] = n->children[j - 1];
+					new (n->keys()) Key(in->keys()[i - 1]);
+					n->children[0] = l->children[l->count];
+					n->count++;
+					set_key(in, i - 1, l->keys()[l->count - 1]);
+					l->keys()[l->count - 1].~Key();
+					l->count--;
+				}
+			}
+
+			void borrow_right(inner_type* in, unsigned i) {
+				BPnode* c = in->children[i];
+				BPnode* right = in->children[i + 1];
+
+				if (c->is_leaf)
+				{
+					leaf_type* r = static_cast<leaf_type*>(right);
+					leaf_type* n = static_cast<leaf_type*>(c);
+					move_slot(n->slots() + n->count, r->slots());
+					for (unsigned j = 1; j < r->count; j++)
+						move_slot(r->slots() + j - 1, r->slots() + j);
+					r->count--;
+					n->count++;
+					set_key(in, i, r->slots()[0].first);
+				}
+				else
+				{
+					inner_type* r = static_cast<inner_type*>(right);
+					inner_type* n = static_cast<inner_type*>(c);
+					new (n->keys() + n->count) Key(in->keys()[i]);
+					n->children[n->count + 1] = r->children[0];
+					n->count++;
+					set_key(in, i, r->keys()[0]);
+					r->keys()[0].~Key();
+					for (unsigned j = 1; j < r->count; j++)
+					{
+						new (r->keys() + j - 1) Key(r->keys()[j]);
+						r->keys()[j].~Key();
+					}
+					for (unsigned j = 0; j < r->count; j++)
+						r->children[j] = r->children[j + 1];
+					r->count--;
+				}
+			}
+
+			//fusionne l'enfant i + 1 dans l'enfant i
+			void merge(inner_type* in, unsigned i) {
+				BPnode* c = in->children[i];
+				BPnode* right = in->children[i + 1];
+
+				if (c->is_leaf)
+				{
+					leaf_type* r = static_cast<leaf_type*>(right);
+					leaf_type* n = static_cast<leaf_type*>(c);
+					for (unsigned j = 0; j < r->count; j++)
+						move_slot(n->slots() + n->count + j, r->slots() + j);
+					n->count += r->count;
+					r->count = 0;
+					n->next = r->next;
+					if (r->next)
+						r->next->prev = n;
+					else
+						tail = n;
+					free_leaf(r);
+				}
+				else
+				{
+					inner_type* r = static_cast<inner_type*>(right);
+					inner_type* n = static_cast<inner_type*>(c);
+					new (n->keys() + n->count) Key(in->keys()[i]);
+					for (unsigned j = 0; j < r->count; j++)
+					{
+						new (n->keys() + n->count + 1 + j) Key(r->keys()[j]);
+						n->children[n->count + 1 + j] = r->children[j];
+					}
+					n->children[n->count + 1 + r->count] = r->children[r->count];
+					n->count += r->count + 1;
+					free_inner(r);
+				}
+				remove_entry(in, i);
+			}
+
+			void copy_from(const BPtree& x) {
+				help_clear(root);
+				root = head = tail = 0;
+				try
+				{
+					root = help_copy(x.root);
+				}
+				catch (...)
+				{
+					free_partial();
+					throw;
+				}
+				_size = x._size;
+			}
+
+			//les feuilles copiees sont chainees au fur et a mesure (ordre de la copie = ordre des cles)
+			BPnode* help_copy(BPnode* src) {
+				if (src->is_leaf)
+				{
+					leaf_type* s = static_cast<leaf_type*>(src);
+					leaf_type* leaf = new_leaf();
+					leaf->prev = tail;
+					if (tail)
+						tail->next = leaf;
+					else
+						head = leaf;
+					tail = leaf;
+					for (unsigned i = 0; i < s->count; i++)
+					{
+						alloc.construct(leaf->slots() + i, s->slots()[i]);
+						leaf->count++;
+					}
+					return leaf;
+				}
+				inner_type* s = static_cast<inner_type*>(src);
+				inner_type* in = new_inner();
+				unsigned	built = 0;
+				try
+				{
+					for (; built <= s->count; built++)
+					{
+						in->children[built] = help_copy(s->children[built]);
+						if (built < s->count)
+						{
+							new (in->keys() + built) Key(s->keys()[built]);
+							in->count++;
+						}
+					}
+				}
+				catch (...)
+				{
+					for (unsigned i = 0; i < built; i++)
+						free_inners(in->children[i]);
+					free_inner(in);
+					throw;
+				}
+				return in;
+			}
+	};
+
+	// Storage policy for ft::map, which then loses reference stability
+	// (every insert or erase invalidates all iterators and references):
+	//   ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, ft::bplus_tree_policy<> >
+	template <std::size_t NodeBytes = 256>
+	struct bplus_tree_policy {
+		template <class Key, class V, class KeyCompare, class ValueCompare, class Alloc>
+		struct apply {
+			typedef BPtree<Key, V, KeyCompare, Alloc, NodeBytes>	type;
+		};
+	};
+}
@@ -1,29 +1,33 @@
 #pragma once
 #include <iostream>
+#include <limits>
+#include <type_traits>
+#include "utils/pool_allocator.hpp"
+#include "utils/tagged_ptr.hpp"
 
 namespace ft {
 	template <class T>
 	struct Node {
-		T		content;
-		Node*	parent;
-		Node*	left;
-		Node*	right;
-		int		color; // 1 = red; 0 = black; -1 = double black
+		T						content;
+		ft::tagged_ptr<Node, 1>	parent; // bit de poids faible : couleur, 1 = red; 0 = black
+		Node*					left;
+		Node*					right;
+		std::size_t				size; // noeuds du sous-arbre, celui-ci compris
 
 		Node()	:	content(T()),
-					parent(0),
+					parent(0, 1),
 					left(0),
 					right(0),
-					color(1)
+					size(1)
 		{
 			// std::cout << "empty node constructor\n";
 		}
 
 		Node(const T& value)	:	content(value),
-									parent(0),
+									parent(0, 1),
 									left(0),
 									right(0),
-									color(1)
+									size(1)
 		{
 			// std::cout << "value node constructor\n";
 		}
@@ -33,7 +37,7 @@ namespace ft {
 			parent(n.parent),
 			left(n.left),
 			right(n.right),
-			color(n.color) {
+			size(n.size) {
 				// std::cout << "copy node constructor\n";
 			}
 
@@ -41,15 +45,34 @@ namespace ft {
 			// std::cout << "node destructor\n";
 		}
 
+		//la couleur n'est pas copiee : parent la conserve a l'affectation
 		Node& operator=(const Node& n) {
 			content = n.content;
 			parent = n.parent;
 			left = n.left;
 			right = n.right;
+			size = n.size;
 			// std::cout << "node operator=()\n";
 			return *this;
 		}
 
+		int color() const {
+			return static_cast<int>(parent.tag());
+		}
+
+		void set_color(int c) {
+			parent.set_tag(c);
+		}
+
+		static std::size_t subtree_size(const Node* n) {
+			return n ? n->size : 0;
+		}
+
+		//recalcule size a partir des enfants
+		void update_size() {
+			size = 1 + subtree_size(left) + subtree_size(right);
+		}
+
 		//Should I protect if this = 0 ??????
 		Node* leftmost() {
 			Node* ret = this;
@@ -88,6 +111,8 @@ namespace ft {
 			this->parent = x;
 			if(y)
 				y->parent = this;
+			x->size = this->size;
+			this->update_size();
 			return(x);
 		}
 
@@ -100,6 +125,8 @@ namespace ft {
 			this->parent = x;
 			if(y)
 				y->parent = this;
+			x->size = this->size;
+			this->update_size();
 			return(x);
 		}
 	};
@@ -120,13 +147,7 @@ namespace ft {
 
 			tree_set_iterator() : n(0) {}
 			tree_set_iterator(node_pointer _n) : n(_n) {}
-			tree_set_iterator(const tree_set_iterator& x) : n(x.n) {}
 			tree_set_iterator(const tree_const_iterator<T>& x) : n(x.as_node()) {}
-			~tree_set_iterator() {}
-			tree_set_iterator& operator=(const tree_set_iterator& x) {
-				n = x.n;
-				return *this;
-			}
 
 			reference operator*() const { return n->content; }
 
@@ -187,12 +208,6 @@ namespace ft {
 
 			tree_iterator() : n(0) {}
 			tree_iterator(node_pointer _n) : n(_n) {}
-			tree_iterator(const tree_iterator& x) : n(x.n) {}
-			~tree_iterator() {}
-			tree_iterator& operator=(const tree_iterator& x) {
-				n = x.n;
-				return *this;
-			}
 
 			reference operator*() const { return n->content; }
 
@@ -253,14 +268,8 @@ namespace ft {
 
 			tree_const_iterator() : n(0) {}
 			tree_const_iterator(node_pointer _n) : n(_n) {}
-			tree_const_iterator(const tree_const_iterator& x) : n(x.n) {}
 			tree_const_iterator(const tree_iterator<T>& x) : n(x.as_node()) {}
 			tree_const_iterator(const tree_set_iterator<T>& x) : n(x.as_node()) {}
-			~tree_const_iterator() {}
-			tree_const_iterator& operator=(const tree_const_iterator& x) {
-				n = x.n;
-				return *this;
-			}
 
 			reference operator*() const { return n->content; }
 
@@ -359,47 +368,63 @@ namespace ft {
 						root = node_alloc.allocate(1);
 						node_type new_node;
 						node_alloc.construct(root, new_node);
-						const_iterator itb = x.begin();
-						const_iterator ite = x.end();
-						for (const_iterator it = itb; it != ite; it++)
-							insert(*it);
+						try
+						{
+							copy_from(x, 0);
+						}
+						catch (...)
+						{
+							node_alloc.destroy(root);
+							node_alloc.deallocate(root, 1);
+							throw;
+						}
 					}
 			
 			~RBbst() {
-				help_clear(root);
+				if (!release_all())
+					help_clear(root);
 			}
 			
+			//les noeuds de l'arbre courant sont recycles pour la copie
 			RBbst& operator= (const RBbst& x) {
+				if (this == &x)
+					return *this;
 				comp = x.comp;
-				node_alloc = x.node_alloc;
-				while (_size)
-				{
-					erase(begin().as_node());
-				}
-				const_iterator itb = x.begin();
-				const_iterator ite = x.end();
-				for (const_iterator it = itb; it != ite; it++)
-					insert(*it);
+				node_pointer reuse = 0;
+				//moins de la moitie des noeuds a garder : un pool les rend tous d'un coup
+				if (!(x._size < _size / 2 && root->left && release_tree()))
+					reuse = flatten(root->left, x._size);
+				root->left = 0;
+				_size = 0;
+				copy_from(x, reuse);
 				return *this;
 			}
 
+			//libere le sous-arbre n sans recursion ni reequilibrage : le fils gauche
+			//est remonte par rotation tant qu'il y en a un, puis le noeud est libere
+			//et son sous-arbre droit prend sa place. O(n), sans pile
 			void help_clear(node_pointer n) {
-				if (n->left)
-				{
-					help_clear(n->left);
-					n->left = 0;
-				}
-				if (n->right)
+				while (n)
 				{
-					help_clear(n->right);
-					n->right = 0;	
+					if (n->left)
+					{
+						node_pointer l = n->left;
+						n->left = l->right;
+						l->right = n;
+						n = l;
+					}
+					else
+					{
+						node_pointer next = n->right;
+						node_alloc.destroy(n);
+						node_alloc.deallocate(n, 1);
+						n = next;
+					}
 				}
-				node_alloc.destroy(n);
-				node_alloc.deallocate(n, 1);
 			}
 
 			void clear() {
-				if (root->left)
+				if (root->left && !release_tree())
 					help_clear(root->left);
 				root->left = 0;
 				_size = 0;
@@ -426,8 +451,6 @@ namespace ft {
 			}
 			
 			ft::pair<iterator,bool> insert(const value_type& val) {
-				ft::pair<iterator,bool>		ret;
-				node_type					new_node(val);
 				node_pointer				cur = root->left;
 				node_pointer				prev = root;
 				bool						side = false;	// side == false -> left / side == true -> right
@@ -448,6 +471,49 @@ namespace ft {
 					else
 						return ft::make_pair<iterator, bool> (iterator(cur), false);
 				}
+				return ft::make_pair<iterator, bool> (iterator(insert_at(prev, side, val)), true);
+			}
+
+			//insertion en O(1) comparaisons quand val se place juste avant ou juste apres hint,
+			//descente complete sinon
+			iterator insert(iterator hint, const value_type& val) {
+				node_pointer	h = hint.as_node();
+
+				if (h == root)
+				{
+					if (!_size)
+						return insert(val).first;
+					node_pointer last = root->left->rightmost();
+					if (comp(last->content, val))
+						return iterator(insert_at(last, true, val));
+					return insert(val).first;
+				}
+				if (comp(val, h->content))
+				{
+					node_pointer prev = h->left ? h->left->rightmost() : h->first_left_parent();
+					if (prev && !comp(prev->content, val))
+						return insert(val).first;
+					if (!h->left)
+						return iterator(insert_at(h, false, val));
+					return iterator(insert_at(prev, true, val));
+				}
+				if (comp(h->content, val))
+				{
+					node_pointer next = h->right ? h->right->leftmost() : h->first_right_parent();
+					if (next != root && !comp(val, next->content))
+						return insert(val).first;
+					if (!h->right)
+						return iterator(insert_at(h, true, val));
+					return iterator(insert_at(next, false, val));
+				}
+				return hint;
+			}
+
+			//accroche un nouveau noeud sous prev (a droite si side) puis reequilibre
+			node_pointer insert_at(node_pointer prev, bool side, const value_type& val) {
+				node_type					new_node(val);
+				node_pointer				cur;
+				node_pointer				ret;
 
 				cur = node_alloc.allocate(1);
 				new_node.parent = prev;
@@ -457,7 +523,10 @@ namespace ft {
 				else
 					prev->left = cur;
 				_size++;
-				ret = ft::make_pair<iterator, bool> (iterator(cur), true);
+				ret = cur;
+				//les rotations qui suivent gardent les tailles a jour localement
+				for (node_pointer n = prev; n != root; n = n->parent)
+					n->size++;
 
 				bool balanced = false;
 				node_pointer	uncle;
@@ -465,23 +534,23 @@ namespace ft {
 				{
 					if (cur == root->left)
 					{
-						cur->color = 0;
+						cur->set_color(0);
 						balanced = true;
 					}
 					else
 					{
-						if (cur->parent->color == 1)
+						if (cur->parent->color() == 1)
 						{
 							if (cur->parent == cur->parent->parent->left)
 								uncle = cur->parent->parent->right;
 							else
 								uncle = cur->parent->parent->left;
 							
-							if (uncle && uncle->color == 1)
+							if (uncle && uncle->color() == 1)
 							{
-								uncle->color = 0;
-								cur->parent->color = 0;
-								cur->parent->parent->color = 1;
+								uncle->set_color(0);
+								cur->parent->set_color(0);
+								cur->parent->parent->set_color(1);
 								cur = cur->parent->parent;
 							}
 							else
@@ -496,16 +565,16 @@ namespace ft {
 									if (cur == cur->parent->left)
 									{
 										G = G->rotateRight();
-										G->color = 0;
-										G->right->color = 1;
+										G->set_color(0);
+										G->right->set_color(1);
 									}
 									else
 									{
 										G->left = G->left->rotateLeft();
 										G->left->parent = G;
 										G = G->rotateRight();
-										G->color = 0;
-										G->right->color = 1;
+										G->set_color(0);
+										G->right->set_color(1);
 									}
 								}
 								else
@@ -513,16 +582,16 @@ namespace ft {
 									if (cur == cur->parent->right)
 									{
 										G = G->rotateLeft();
-										G->color = 0;
-										G->left->color = 1;
+										G->set_color(0);
+										G->left->set_color(1);
 									}
 									else
 									{
 										G->right = G->right->rotateRight();
 										G->right->parent = G;
 										G = G->rotateLeft();
-										G->color = 0;
-										G->left->color = 1;
+										G->set_color(0);
+										G->left->set_color(1);
 									}
 								}
 								G->parent = GG;
@@ -573,24 +642,45 @@ namespace ft {
 				}
 			}
 
-			size_type erase(value_type val) {
-				iterator ite = end();
-				iterator itk = find(val);
-				if (itk == ite)
+			size_type erase(const value_type& val) {
+				return erase(val, comp);
+			}
+
+			//c compare une cle k a un contenu dans les deux sens
+			template <class K, class C>
+			size_type erase(const K& k, C c) {
+				node_pointer n = find_node(k, c);
+				if (n == root)
 					return 0;
-				erase(itk.as_node());
+				erase(n);
 				return 1;
 			}
 
+			void erase(iterator position) {
+				erase(position.as_node());
+			}
+
+			void erase(iterator first, iterator last) {
+				//tout l'arbre : pas de reequilibrage noeud par noeud
+				if (first == begin() && last == end())
+				{
+					clear();
+					return ;
+				}
+				while (first != last)
+					erase((first++).as_node());
+			}
+
 			void erase(node_pointer v) {
 				node_pointer	u;
-				bool			v_color = v->color;
+				bool			v_color = v->color();
 				node_pointer	p;
 				node_pointer	s;
 
 				//Si v est une feuille ou un noeud mono enfant
 				if (!v->right || !v->left)
 				{
+					shrink_path(v->parent);
 					u = help_erase(v);
 					p = v->parent;
 					s = get_sibling(u, p);
@@ -602,6 +692,8 @@ namespace ft {
 					//Si 2 enfants, remplacer v par son successeur puis erase le successeur
 					iterator it(v);
 					node_pointer successor = (++it).as_node();
+					//v est sur le chemin du successeur
+					shrink_path(successor->parent);
 					u = help_erase(successor);
 					if (v == v->parent->left)
 						v->parent->left = successor;
@@ -617,8 +709,10 @@ namespace ft {
 					}
 					successor->left = v->left;
 					successor->right = v->right;
-					successor->color = v->color;
+					v_color = successor->color();
+					successor->set_color(v->color());
 					successor->parent = v->parent;
+					successor->size = v->size;
 					if (v->left)
 						v->left->parent = successor;
 					if (v->right)
@@ -628,10 +722,10 @@ namespace ft {
 					node_alloc.deallocate(v, 1);
 				}
 
-				if (v_color || (u && u->color))
+				if (v_color || (u && u->color()))
 				{
 					if (u)
-						u->color = 0;
+						u->set_color(0);
 				}
 				else
 				{
@@ -643,78 +737,196 @@ namespace ft {
 					std::cout << "Hello\n";
 			}
 
-			iterator find(value_type val) {
-				iterator ite = end();
-				if (_size == 0)
-					return ite;
-				bool not_found = true;
-				node_pointer cur = root->left;
-				while(not_found && cur)
+			iterator find(const value_type& val) {
+				return iterator(find_node(val, comp));
+			}
+
+			const_iterator find(const value_type& val) const {
+				return const_iterator(find_node(val, comp));
+			}
+
+			template <class K, class C>
+			iterator find(const K& k, C c) {
+				return iterator(find_node(k, c));
+			}
+
+			template <class K, class C>
+			const_iterator find(const K& k, C c) const {
+				return const_iterator(find_node(k, c));
+			}
+
+			//cherche les cles de [first, last) en entrelacant leurs descentes : pendant que
+			//le noeud d'une recherche arrive de la memoire, les autres avancent.
+			//*out++ recoit un iterateur par cle, dans l'ordre, end() si la cle est absente
+			template <class ForwardIterator, class OutputIterator, class C>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out, C c) {
+				return help_find_batch<iterator>(first, last, out, c);
+			}
+
+			template <class ForwardIterator, class OutputIterator, class C>
+			OutputIterator find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out, C c) const {
+				return help_find_batch<const_iterator>(first, last, out, c);
+			}
+
+			//appelle f sur chaque element dans l'ordre, sans iterateur : une pile
+			//explicite remplace les remontees par parent de operator++.
+			//f ne doit ni inserer ni supprimer
+			template <class F>
+			void for_each(F& f) {
+				node_pointer	stack[max_depth];
+				walk<value_type&>(stack, push_path(stack, root->left, no_bound()), f, no_bound());
+			}
+
+			template <class F>
+			void for_each(F& f) const {
+				node_pointer	stack[max_depth];
+				walk<const value_type&>(stack, push_path(stack, root->left, no_bound()), f, no_bound());
+			}
+
+			//meme chose pour les elements de [lo, hi)
+			template <class K, class C, class F>
+			void for_each_range(const K& lo, const K& hi, C c, F& f) {
+				node_pointer	stack[max_depth];
+				walk<value_type&>(stack, push_path(stack, root->left, lower_bound_of<K, C>(lo, c)), f, below<K, C>(hi, c));
+			}
+
+			template <class K, class C, class F>
+			void for_each_range(const K& lo, const K& hi, C c, F& f) const {
+				node_pointer	stack[max_depth];
+				walk<const value_type&>(stack, push_path(stack, root->left, lower_bound_of<K, C>(lo, c)), f, below<K, C>(hi, c));
+			}
+
+			size_type size() const { return _size; }
+
+			//k-ieme element (a partir de 0) en O(log n), end() si k >= size()
+			iterator nth(size_type k) {
+				return iterator(nth_node(k));
+			}
+
+			const_iterator nth(size_type k) const {
+				return const_iterator(nth_node(k));
+			}
+
+			//nombre d'elements strictement inferieurs a k
+			template <class K, class C>
+			size_type rank(const K& k, C c) const {
+				node_pointer	cur = root->left;
+				size_type		ret = 0;
+				while (cur)
 				{
-					if (comp(val, cur->content))
-						cur = cur->left;
-					else if (comp(cur->content, val))
+					if (c(cur->content, k))
+					{
+						ret += node_type::subtree_size(cur->left) + 1;
 						cur = cur->right;
+					}
 					else
-						not_found = false;
+						cur = cur->left;
 				}
-				if (cur)
-					return iterator(cur);
-				return ite;
+				return ret;
 			}
 
-			const_iterator find(value_type val) const {
-				const_iterator ite = end();
-				if (_size == 0)
-					return ite;
-				bool not_found = true;
-				node_pointer cur = root->left;
-				while(not_found && cur)
+			//position de it dans l'ordre, size() pour end()
+			size_type index_of(const_iterator it) const {
+				node_pointer	n = it.as_node();
+				if (n == root)
+					return _size;
+				size_type		ret = node_type::subtree_size(n->left);
+				for (; n->parent != root; n = n->parent)
+					if (n == n->parent->right)
+						ret += node_type::subtree_size(n->parent->left) + 1;
+				return ret;
+			}
+
+			//vrai si [first, last) est strictement croissant selon comp
+			template <class InputIterator>
+			bool is_sorted_unique(InputIterator first, InputIterator last) const {
+				if (first == last)
+					return true;
+				InputIterator prev = first;
+				while (++first != last)
 				{
-					if (comp(val, cur->content))
-						cur = cur->left;
-					else if (comp(cur->content, val))
-						cur = cur->right;
-					else
-						not_found = false;
+					if (!comp(*prev, *first))
+						return false;
+					prev = first;
 				}
-				if (cur)
-					return const_iterator(cur);
-				return ite;
+				return true;
 			}
 
-			size_type size() const { return _size; }
+			//construit l'arbre en O(n) a partir d'une suite strictement croissante
+			//l'arbre doit etre vide
+			template <class InputIterator>
+			void build_sorted(InputIterator first, InputIterator last) {
+				node_pointer	head = 0;
+				node_pointer	tail = 0;
+				size_type		n = 0;
+
+				//les noeuds sont chaines dans l'ordre par right
+				try
+				{
+					for (; first != last; ++first)
+					{
+						node_pointer	cur = node_alloc.allocate(1);
+						try
+						{
+							node_type	new_node(*first);
+							node_alloc.construct(cur, new_node);
+						}
+						catch (...)
+						{
+							node_alloc.deallocate(cur, 1);
+							throw;
+						}
+						if (tail)
+							tail->right = cur;
+						else
+							head = cur;
+						tail = cur;
+						n++;
+					}
+				}
+				catch (...)
+				{
+					free_chain(head);
+					throw;
+				}
+
+				attach_list(head, n);
+			}
 
 			iterator lower_bound(const value_type& val) {
-				iterator it_cur = begin();
-				iterator ite = end();
-				while (comp(it_cur.as_node()->content, val) && it_cur != ite)
-					it_cur++;
-				return it_cur;
+				return iterator(lower_bound_node(val, comp));
 			}
 
 			const_iterator lower_bound(const value_type& val) const {
-				const_iterator it_cur = begin();
-				const_iterator ite = end();
-				while (comp(it_cur.as_node()->content, val) && it_cur != ite)
-					it_cur++;
-				return it_cur;
+				return const_iterator(lower_bound_node(val, comp));
 			}
 
 			iterator upper_bound(const value_type& val) {
-				iterator it_cur = begin();
-				iterator ite = end();
-				while (!comp(val, it_cur.as_node()->content) && it_cur != ite)
-					it_cur++;
-				return it_cur;
+				return iterator(upper_bound_node(val, comp));
 			}
 
 			const_iterator upper_bound(const value_type& val) const {
-				const_iterator it_cur = begin();
-				const_iterator ite = end();
-				while (!comp(val, it_cur.as_node()->content) && it_cur != ite)
-					it_cur++;
-				return it_cur;
+				return const_iterator(upper_bound_node(val, comp));
+			}
+
+			template <class K, class C>
+			iterator lower_bound(const K& k, C c) {
+				return iterator(lower_bound_node(k, c));
+			}
+
+			template <class K, class C>
+			const_iterator lower_bound(const K& k, C c) const {
+				return const_iterator(lower_bound_node(k, c));
+			}
+
+			template <class K, class C>
+			iterator upper_bound(const K& k, C c) {
+				return iterator(upper_bound_node(k, c));
+			}
+
+			template <class K, class C>
+			const_iterator upper_bound(const K& k, C c) const {
+				return const_iterator(upper_bound_node(k, c));
 			}
 
 			void swap(RBbst & x) {
@@ -724,22 +936,437 @@ namespace ft {
 				root = x.root;
 				x._size = size_tmp;
 				x.root = root_tmp;
+				node_alloc_type alloc_tmp = node_alloc;
+				node_alloc = x.node_alloc;
+				x.node_alloc = alloc_tmp;
 			}
 
 			size_type max_size() const {
 				return (node_alloc.max_size());
 			}
 
+			//operations ensemblistes par join / split : les noeuds passent d'un arbre a
+			//l'autre sans copie, en O(m log(n/m + 1)) pour m elements face a n.
+			//Si les allocateurs different, les elements sont copies un par un.
+			//comp ne doit pas lever d'exception pendant ces operations
+
+			//ajoute les elements de x, tous superieurs a ceux de l'arbre ; x est vide ensuite
+			void join(RBbst& x) {
+				if (this == &x || !x._size)
+					return ;
+				if (!(node_alloc == x.node_alloc))
+				{
+					for (iterator it = x.begin(); it != x.end(); ++it)
+						insert(end(), *it);
+					x.clear();
+					return ;
+				}
+				subtree r = x.detach();
+				attach(join2(detach(), r));
+			}
+
+			//deplace dans out les elements non inferieurs a k, out perd son contenu
+			template <class K, class C>
+			void split(const K& k, C c, RBbst& out) {
+				subtree			l;
+				subtree			r;
+
+				out.clear();
+				out.share_allocator(node_alloc);
+				node_pointer m = split_at(detach(), k, c, l, r);
+				if (m)
+					r = join(subtree(), m, r);
+				attach(l);
+				out.attach(r);
+			}
+
+			//deplace dans out les elements de [lo, hi), out perd son contenu
+			template <class K, class C>
+			void extract_range(const K& lo, const K& hi, C c, RBbst& out) {
+				subtree			below;
+				subtree			rest;
+				subtree			range;
+				subtree			above;
+
+				out.clear();
+				out.share_allocator(node_alloc);
+				node_pointer m = split_at(detach(), lo, c, below, rest);
+				if (m)
+					rest = join(subtree(), m, rest);
+				m = split_at(rest, hi, c, range, above);
+				if (m)
+					above = join(subtree(), m, above);
+				attach(join2(below, above));
+				out.attach(range);
+			}
+
+			//union : prend les elements de x absents de l'arbre, x garde les autres
+			void merge(RBbst& x) {
+				if (this == &x || !x._size)
+					return ;
+				if (!(node_alloc == x.node_alloc))
+				{
+					for (iterator it = x.begin(); it != x.end(); )
+					{
+						if (insert(*it).second)
+							x.erase(it++);
+						else
+							++it;
+					}
+					return ;
+				}
+				chain			dup;
+				subtree			other = x.detach();
+
+				attach(unite(detach(), other, dup));
+				x.attach_list(dup.head, dup.n);
+			}
+
+			//intersection : ne garde que les elements presents dans x
+			void intersect(const RBbst& x) {
+				if (this != &x)
+					attach(intersect_with(detach(), x.root->left));
+			}
+
+			//difference : retire les elements presents dans x
+			void subtract(const RBbst& x) {
+				if (this == &x)
+					clear();
+				else
+					attach(subtract_with(detach(), x.root->left));
+			}
+
 		private:
 			node_pointer	root;
 			Comp			comp;
 			node_alloc_type	node_alloc;
 			size_type		_size;
 
+			//noeud equivalent a k, root (end) sinon
+			template <class K, class C>
+			node_pointer find_node(const K& k, C c) const {
+				node_pointer	cur = root->left;
+				while (cur)
+				{
+					if (c(k, cur->content))
+						cur = cur->left;
+					else if (c(cur->content, k))
+						cur = cur->right;
+					else
+						return cur;
+				}
+				return root;
+			}
+
+			node_pointer nth_node(size_type k) const {
+				node_pointer	cur = root->left;
+				if (k >= _size)
+					return root;
+				while (cur)
+				{
+					size_type left = node_type::subtree_size(cur->left);
+					if (k < left)
+						cur = cur->left;
+					else if (k == left)
+						return cur;
+					else
+					{
+						k -= left + 1;
+						cur = cur->right;
+					}
+				}
+				return root;
+			}
+
+			//nombre de recherches menees de front par find_batch
+			static const unsigned	batch_lanes = 8;
+
+			template <class It, class ForwardIterator, class OutputIterator, class C>
+			OutputIterator help_find_batch(ForwardIterator first, ForwardIterator last, OutputIterator out, C c) const {
+				ForwardIterator	keys[batch_lanes];
+				node_pointer	cur[batch_lanes];
+				node_pointer	found[batch_lanes];
+
+				while (first != last)
+				{
+					unsigned n = 0;
+					for (; n < batch_lanes && first != last; ++n, ++first)
+					{
+						keys[n] = first;
+						cur[n] = root->left;
+						found[n] = root;
+					}
+					//un niveau par tour pour chaque recherche encore en cours
+					for (bool active = true; active; )
+					{
+						active = false;
+						for (unsigned i = 0; i < n; i++)
+						{
+							node_pointer x = cur[i];
+							if (!x)
+								continue;
+							if (c(*keys[i], x->content))
+								x = x->left;
+							else if (c(x->content, *keys[i]))
+								x = x->right;
+							else
+							{
+								found[i] = x;
+								x = 0;
+							}
+							cur[i] = x;
+							if (x)
+							{
+								ft::prefetch(x);
+								active = true;
+							}
+						}
+					}
+					for (unsigned i = 0; i < n; i++)
+						*out++ = It(found[i]);
+				}
+				return out;
+			}
+
+			//hauteur maximale d'un arbre rouge-noir de max_size() noeuds : 2 log2(n + 1)
+			static const unsigned	max_depth = 2 * std::numeric_limits<size_type>::digits;
+
+			//bornes de for_each_range ; no_bound laisse tout passer
+			struct no_bound {
+				bool operator()(const value_type&) const { return true; }
+			};
+
+			template <class K, class C>
+			struct below {
+				const K&	hi;
+				C			c;
+				below(const K& _hi, C _c) : hi(_hi), c(_c) {}
+				bool operator()(const value_type& x) const { return c(x, hi); }
+			};
+
+			template <class K, class C>
+			struct lower_bound_of {
+				const K&	lo;
+				C			c;
+				lower_bound_of(const K& _lo, C _c) : lo(_lo), c(_c) {}
+				bool operator()(const value_type& x) const { return !c(x, lo); }
+			};
+
+			//empile le chemin vers le premier noeud accepte par from : les noeuds
+			//dont il reste a visiter le contenu puis le sous-arbre droit, le plus petit
+			//au sommet. Renvoie la hauteur de la pile
+			template <class From>
+			static unsigned push_path(node_pointer* stack, node_pointer cur, From from) {
+				unsigned	top = 0;
+				while (cur)
+				{
+					if (from(cur->content))
+					{
+						ft::prefetch(cur->right);
+						stack[top++] = cur;
+						cur = cur->left;
+					}
+					else
+						cur = cur->right;
+				}
+				return top;
+			}
+
+			//parcours infixe de la pile ; s'arrete au premier contenu refuse par bound.
+			//les fils droits sont precharges a l'empilement, bien avant leur visite
+			template <class Ref, class F, class Bound>
+			static void walk(node_pointer* stack, unsigned top, F& f, Bound bound) {
+				while (top)
+				{
+					node_pointer x = stack[--top];
+					if (!bound(x->content))
+						return ;
+					f(static_cast<Ref>(x->content));
+					for (x = x->right; x; x = x->left)
+					{
+						ft::prefetch(x->right);
+						stack[top++] = x;
+					}
+				}
+			}
+
+			//premier noeud dont le contenu n'est pas inferieur a k, root (end) sinon
+			template <class K, class C>
+			node_pointer lower_bound_node(const K& k, C c) const {
+				node_pointer	cur = root->left;
+				node_pointer	res = root;
+				while (cur)
+				{
+					if (!c(cur->content, k))
+					{
+						res = cur;
+						cur = cur->left;
+					}
+					else
+						cur = cur->right;
+				}
+				return res;
+			}
+
+			//premier noeud dont le contenu est superieur a k, root (end) sinon
+			template <class K, class C>
+			node_pointer upper_bound_node(const K& k, C c) const {
+				node_pointer	cur = root->left;
+				node_pointer	res = root;
+				while (cur)
+				{
+					if (c(k, cur->content))
+					{
+						res = cur;
+						cur = cur->left;
+					}
+					else
+						cur = cur->right;
+				}
+				return res;
+			}
+
+			//consomme n noeuds de la liste et retourne la racine du sous-arbre equilibre
+			node_pointer help_build(node_pointer& list, size_type n, int depth, int red_depth) {
+				if (n == 0)
+					return 0;
+				size_type		left_n = (n - 1) / 2;
+				node_pointer	left = help_build(list, left_n, depth + 1, red_depth);
+				node_pointer	mid = list;
+				list = list->right;
+				mid->left = left;
+				mid->right = help_build(list, n - 1 - left_n, depth + 1, red_depth);
+				if (mid->left)
+					mid->left->parent = mid;
+				if (mid->right)
+					mid->right->parent = mid;
+				mid->set_color((depth && depth == red_depth) ? 1 : 0);
+				mid->size = n;
+				return mid;
+			}
+
+			//copie la forme et les couleurs de x en O(n), en piochant d'abord dans reuse
+			void copy_from(const RBbst& x, node_pointer reuse) {
+				try
+				{
+					if (x.root->left)
+						help_copy(x.root->left, root, root->left, reuse);
+				}
+				catch (...)
+				{
+					if (root->left)
+						help_clear(root->left);
+					root->left = 0;
+					free_chain(reuse);
+					throw;
+				}
+				free_chain(reuse);
+				_size = x._size;
+			}
+
+			//chaque noeud est accroche a son parent avant de copier ses enfants,
+			//ainsi une exception laisse un arbre partiel que help_clear sait liberer
+			void help_copy(node_pointer src, node_pointer parent, node_pointer& slot, node_pointer& reuse) {
+				node_pointer	n;
+				if (reuse)
+				{
+					n = reuse;
+					reuse = reuse->right;
+					node_alloc.destroy(n);
+				}
+				else
+					n = node_alloc.allocate(1);
+				try
+				{
+					node_type	new_node(src->content);
+					node_alloc.construct(n, new_node);
+				}
+				catch (...)
+				{
+					node_alloc.deallocate(n, 1);
+					throw;
+				}
+				n->set_color(src->color());
+				n->size = src->size;
+				n->parent = parent;
+				slot = n;
+				if (src->left)
+					help_copy(src->left, n, n->left, reuse);
+				if (src->right)
+					help_copy(src->right, n, n->right, reuse);
+			}
+
+			//transforme le sous-arbre n en liste chainee par right, sans recursion ;
+			//au-dela de keep noeuds, les suivants sont liberes dans le meme passage
+			node_pointer flatten(node_pointer n, size_type keep = std::numeric_limits<size_type>::max()) {
+				node_pointer	list = 0;
+				while (n)
+				{
+					if (n->left)
+					{
+						node_pointer l = n->left;
+						n->left = l->right;
+						l->right = n;
+						n = l;
+					}
+					else
+					{
+						node_pointer next = n->right;
+						if (keep)
+						{
+							n->right = list;
+							list = n;
+							keep--;
+						}
+						else
+						{
+							node_alloc.destroy(n);
+							node_alloc.deallocate(n, 1);
+						}
+						n = next;
+					}
+				}
+				return list;
+			}
+
+			void free_chain(node_pointer list) {
+				while (list)
+				{
+					node_pointer next = list->right;
+					node_alloc.destroy(list);
+					node_alloc.deallocate(list, 1);
+					list = next;
+				}
+			}
+
+			//libere tous les noeuds d'un coup (sentinelle comprise) si l'allocateur
+			//est un pool non partage et que le contenu n'a rien a detruire
+			bool release_all() {
+				if (!std::is_trivially_destructible<T>::value)
+					return false;
+				return ft::release_nodes(node_alloc);
+			}
+
+			//release_all, puis une sentinelle neuve : l'ancienne est partie avec le pool
+			bool release_tree() {
+				if (!release_all())
+					return false;
+				root = node_alloc.allocate(1);
+				node_type new_node;
+				node_alloc.construct(root, new_node);
+				return true;
+			}
+
+			//retire un noeud du compte de n et de ses ancetres
+			void shrink_path(node_pointer n) {
+				for (; n != root; n = n->parent)
+					n->size--;
+			}
+
 			int	get_color(node_pointer n) {
 				if (!n)
 					return 0;
-				return n->color;
+				return n->color();
 			}
 
 			node_pointer get_sibling(node_pointer child, node_pointer parent) {
@@ -773,6 +1400,8 @@ namespace ft {
 					p2->left->parent = p;
 				
 				p2->left = p;
+				p2->size = p->size;
+				p->update_size();
 			}
 
 			void rRotate_d(node_pointer p)
@@ -790,6 +1419,8 @@ namespace ft {
 					p2->right->parent = p;
 				
 				p2->right = p;
+				p2->size = p->size;
+				p->update_size();
 			}
 
 			void handleDoubleBlack(node_pointer u, node_pointer p, node_pointer s) {
@@ -799,9 +1430,9 @@ namespace ft {
 				//no sibling
 				if (s == 0)
 				{
-					if (p->color)
+					if (p->color())
 					{
-						p->color = 0;
+						p->set_color(0);
 						return;
 					}
 					node_pointer u2 = p;
@@ -809,7 +1440,7 @@ namespace ft {
 					node_pointer s2 = get_sibling(p, p2);
 					handleDoubleBlack(u2, p2, s2);
 				}
-				else if (s->color == 0 && (get_color(s->left) || get_color(s->right)))
+				else if (s->color() == 0 && (get_color(s->left) || get_color(s->right)))
 				{
 					//sibling is black and at least one child is red
 					node_pointer r;
@@ -821,13 +1452,13 @@ namespace ft {
 					{
 						if (r == s->left)
 						{
-							s->left->color = s->color;
-							s->color = p->color;
+							s->left->set_color(s->color());
+							s->set_color(p->color());
 							rRotate_d(p);
 						}
 						else
 						{
-							s->right->color = p->color;
+							s->right->set_color(p->color());
 							lRotate_d(s);
 							rRotate_d(p);
 						}
@@ -836,24 +1467,24 @@ namespace ft {
 					{
 						if (r == s->right)
 						{
-							s->right->color = s->color;
-							s->color = p->color;
+							s->right->set_color(s->color());
+							s->set_color(p->color());
 							lRotate_d(p);
 						}
 						else
 						{
-							s->left->color = p->color;
+							s->left->set_color(p->color());
 							rRotate_d(s);
 							lRotate_d(p);
 						}
 					}
-					p->color = 0;
+					p->set_color(0);
 				} // sibling and both its children are black
-				else if (s->color == 0 && get_color(s->left) == 0 && get_color(s->right) == 0)
+				else if (s->color() == 0 && get_color(s->left) == 0 && get_color(s->right) == 0)
 				{
-					s->color = 1;
-					if (p->color)
-						p->color = 0;
+					s->set_color(1);
+					if (p->color())
+						p->set_color(0);
 					else
 					{
 						node_pointer u2 = p;
@@ -864,8 +1495,8 @@ namespace ft {
 				} // sibling is red
 				else
 				{
-					p->color = 1;
-					s->color = 0;
+					p->set_color(1);
+					s->set_color(0);
 					if (s == p->right)
 						lRotate_d(p);
 					else
@@ -875,14 +1506,378 @@ namespace ft {
 				}
 			}
 
+			//sous-arbre detache (sans parent) et sa hauteur noire : nombre de noeuds
+			//noirs d'un chemin de sa racine a une feuille, racine comprise
+			struct subtree {
+				node_pointer	top;
+				int				bh;
+
+				subtree(node_pointer t = 0, int h = 0) : top(t), bh(h) {}
+			};
+
+			//noeuds en attente chaines par right, dans l'ordre
+			struct chain {
+				node_pointer	head;
+				node_pointer	tail;
+				size_type		n;
+
+				chain() : head(0), tail(0), n(0) {}
+
+				void push(node_pointer m) {
+					m->left = 0;
+					m->right = 0;
+					if (tail)
+						tail->right = m;
+					else
+						head = m;
+					tail = m;
+					n++;
+				}
+			};
+
+			//vide l'arbre en rendant ses noeuds sous forme de sous-arbre
+			subtree detach() {
+				node_pointer	t = root->left;
+				int				bh = 0;
+
+				for (node_pointer n = t; n; n = n->left)
+					bh += (n->color() == 0);
+				if (t)
+					t->parent = 0;
+				root->left = 0;
+				_size = 0;
+				return subtree(t, bh);
+			}
+
+			//l'arbre doit etre vide
+			void attach(subtree t) {
+				root->left = t.top;
+				_size = 0;
+				if (t.top)
+				{
+					t.top->parent = root;
+					t.top->set_color(0);
+					_size = t.top->size;
+				}
+			}
+
+			//construit l'arbre (vide) en O(n) a partir de n noeuds chaines par right, dans l'ordre
+			void attach_list(node_pointer head, size_type n) {
+				//seul le dernier niveau (eventuellement incomplet) est rouge
+				int red_depth = 0;
+				for (size_type i = n; i > 1; i /= 2)
+					red_depth++;
+				root->left = help_build(head, n, 0, red_depth);
+				if (root->left)
+					root->left->parent = root;
+				_size = n;
+			}
+
+			//l'arbre doit etre vide : la sentinelle change d'allocateur avec lui
+			void share_allocator(const node_alloc_type& a) {
+				if (node_alloc == a)
+					return ;
+				node_alloc_type	alloc(a);
+				node_pointer	sentinel = alloc.allocate(1);
+				node_type		new_node;
+				alloc.construct(sentinel, new_node);
+				node_alloc.destroy(root);
+				node_alloc.deallocate(root, 1);
+				node_alloc = alloc;
+				root = sentinel;
+			}
+
+			//enfant c de t, detache
+			static subtree take_child(node_pointer c, const subtree& t) {
+				if (c)
+					c->parent = 0;
+				return subtree(c, t.bh - (t.top->color() == 0));
+			}
+
+			static subtree blacken(subtree t) {
+				if (t.top && t.top->color() == 1)
+				{
+					t.top->set_color(0);
+					t.bh++;
+				}
+				return t;
+			}
+
+			static void rotate_left(node_pointer x, node_pointer& top) {
+				node_pointer y = x->right;
+				x->right = y->left;
+				if (y->left)
+					y->left->parent = x;
+				y->parent = x->parent;
+				if (!x->parent)
+					top = y;
+				else if (x == x->parent->left)
+					x->parent->left = y;
+				else
+					x->parent->right = y;
+				y->left = x;
+				x->parent = y;
+				y->size = x->size;
+				x->update_size();
+			}
+
+			static void rotate_right(node_pointer x, node_pointer& top) {
+				node_pointer y = x->left;
+				x->left = y->right;
+				if (y->right)
+					y->right->parent = x;
+				y->parent = x->parent;
+				if (!x->parent)
+					top = y;
+				else if (x == x->parent->right)
+					x->parent->right = y;
+				else
+					x->parent->left = y;
+				y->right = x;
+				x->parent = y;
+				y->size = x->size;
+				x->update_size();
+			}
+
+			//corrige le rouge-rouge entre x et son parent ; vrai si la racine a du
+			//passer au noir, ce qui ajoute un niveau a la hauteur noire
+			static bool fix_red(node_pointer x, node_pointer& top) {
+				while (x->parent && x->parent->color() == 1)
+				{
+					//la racine est noire, un parent rouge a donc un parent
+					node_pointer p = x->parent;
+					node_pointer g = p->parent;
+					node_pointer u = (p == g->left) ? g->right : g->left;
+					if (u && u->color() == 1)
+					{
+						p->set_color(0);
+						u->set_color(0);
+						g->set_color(1);
+						x = g;
+					}
+					else if (p == g->left)
+					{
+						if (x == p->right)
+						{
+							rotate_left(p, top);
+							p = x;
+						}
+						p->set_color(0);
+						g->set_color(1);
+						rotate_right(g, top);
+					}
+					else
+					{
+						if (x == p->left)
+						{
+							rotate_right(p, top);
+							p = x;
+						}
+						p->set_color(0);
+						g->set_color(1);
+						rotate_left(g, top);
+					}
+				}
+				if (top->color() == 1)
+				{
+					top->set_color(0);
+					return true;
+				}
+				return false;
+			}
+
+			//accroche x, rouge, le long du bord droit (ou gauche) de top a la place du
+			//premier noeud noir de meme hauteur noire que s, qui devient l'autre enfant de x
+			static void graft(node_pointer top, int bh, node_pointer x, subtree s, bool right) {
+				node_pointer y = top;
+				node_pointer p = 0;
+
+				while (y && !(y->color() == 0 && bh == s.bh))
+				{
+					p = y;
+					bh -= (y->color() == 0);
+					y = right ? y->right : y->left;
+				}
+				if (right)
+				{
+					x->left = y;
+					x->right = s.top;
+					p->right = x;
+				}
+				else
+				{
+					x->right = y;
+					x->left = s.top;
+					p->left = x;
+				}
+				if (y)
+					y->parent = x;
+				if (s.top)
+					s.top->parent = x;
+				x->parent = p;
+				x->set_color(1);
+				x->update_size();
+				for (; p; p = p->parent)
+					p->size += 1 + node_type::subtree_size(s.top);
+			}
+
+			//l < x < r : arbre de l, x et r en O(|l.bh - r.bh|)
+			static subtree join(subtree l, node_pointer x, subtree r) {
+				l = blacken(l);
+				r = blacken(r);
+				x->parent = 0;
+				if (l.bh == r.bh)
+				{
+					x->left = l.top;
+					x->right = r.top;
+					if (l.top)
+						l.top->parent = x;
+					if (r.top)
+						r.top->parent = x;
+					x->set_color(0);
+					x->update_size();
+					return subtree(x, l.bh + 1);
+				}
+				subtree t = (l.bh > r.bh) ? l : r;
+				if (l.bh > r.bh)
+					graft(l.top, l.bh, x, r, true);
+				else
+					graft(r.top, r.bh, x, l, false);
+				if (fix_red(x, t.top))
+					t.bh++;
+				return t;
+			}
+
+			//retire le plus grand noeud de t, rest recoit le reste
+			static node_pointer pop_last(subtree t, subtree& rest) {
+				node_pointer	n = t.top;
+				subtree			nl = take_child(n->left, t);
+				subtree			nr = take_child(n->right, t);
+
+				if (!nr.top)
+				{
+					rest = nl;
+					return n;
+				}
+				subtree			rr;
+				node_pointer	m = pop_last(nr, rr);
+				rest = join(nl, n, rr);
+				return m;
+			}
+
+			//l < r : join sans noeud central, qui est pris a la fin de l
+			static subtree join2(subtree l, subtree r) {
+				if (!l.top)
+					return r;
+				if (!r.top)
+					return l;
+				subtree			rest;
+				node_pointer	m = pop_last(l, rest);
+				return join(rest, m, r);
+			}
+
+			//coupe t en l (< k) et r (> k) ; retourne le noeud equivalent a k, detache, ou 0
+			template <class K, class C>
+			static node_pointer split_at(subtree t, const K& k, C c, subtree& l, subtree& r) {
+				if (!t.top)
+				{
+					l = subtree();
+					r = subtree();
+					return 0;
+				}
+				node_pointer	n = t.top;
+				subtree			nl = take_child(n->left, t);
+				subtree			nr = take_child(n->right, t);
+				if (c(k, n->content))
+				{
+					subtree			rl;
+					node_pointer	m = split_at(nl, k, c, l, rl);
+					r = join(rl, n, nr);
+					return m;
+				}
+				if (c(n->content, k))
+				{
+					subtree			lr;
+					node_pointer	m = split_at(nr, k, c, lr, r);
+					l = join(nl, n, lr);
+					return m;
+				}
+				l = nl;
+				r = nr;
+				return n;
+			}
+
+			//union de a et b, a l'emporte ; les doublons de b sont chaines dans dup, dans l'ordre
+			subtree unite(subtree a, subtree b, chain& dup) {
+				if (!b.top)
+					return a;
+				if (!a.top)
+					return b;
+				node_pointer	n = a.top;
+				subtree			al = take_child(n->left, a);
+				subtree			ar = take_child(n->right, a);
+				subtree			bl;
+				subtree			br;
+				node_pointer	m = split_at(b, n->content, comp, bl, br);
+				subtree			l = unite(al, bl, dup);
+				if (m)
+					dup.push(m);
+				subtree			r = unite(ar, br, dup);
+				return join(l, n, r);
+			}
+
+			//noeuds de t equivalents a un noeud du sous-arbre x (d'un autre arbre, non modifie)
+			subtree intersect_with(subtree t, const node_type* x) {
+				if (!t.top)
+					return t;
+				if (!x)
+				{
+					help_clear(t.top);
+					return subtree();
+				}
+				subtree			l;
+				subtree			r;
+				node_pointer	m = split_at(t, x->content, comp, l, r);
+				l = intersect_with(l, x->left);
+				r = intersect_with(r, x->right);
+				if (m)
+					return join(l, m, r);
+				return join2(l, r);
+			}
+
+			//noeuds de t sans equivalent dans le sous-arbre x (d'un autre arbre, non modifie)
+			subtree subtract_with(subtree t, const node_type* x) {
+				if (!t.top || !x)
+					return t;
+				subtree			l;
+				subtree			r;
+				node_pointer	m = split_at(t, x->content, comp, l, r);
+				if (m)
+				{
+					node_alloc.destroy(m);
+					node_alloc.deallocate(m, 1);
+				}
+				l = subtract_with(l, x->left);
+				r = subtract_with(r, x->right);
+				return join2(l, r);
+			}
+
 			void ft_print(node_pointer n) {
 				if (n->left)
 					ft_print(n->left);
 				if (n->right)
 					ft_print(n->right);
-				std::cout << n->content.first << " | " << n->content.second << " : " << n->color << "\n";
+				std::cout << n->content.first << " | " << n->content.second << " : " << n->color() << "\n";
 			}
 
 			
 	};
+
+	// Storage policy for ft::map: builds the tree type from the map's types
+	struct rb_tree_policy {
+		template <class Key, class V, class KeyCompare, class ValueCompare, class Alloc>
+		struct apply {
+			typedef RBbst<V, ValueCompare, Alloc>	type;
+		};
+	};
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+// Push/pop throughput of a shared stack used as a free list, from 1 to N threads:
+// ft::stack behind a std::mutex vs the lock-free ft::concurrent_stack
+// c++ -O2 -std=c++11 -pthread bench/concurrent_stack.cpp -o concurrent_stack && ./concurrent_stack [ops_per_thread] [max_threads]
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../stack.hpp"
+#include "../concurrent_stack.hpp"
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct locked_stack
+{
+	std::mutex			lock;
+	ft::stack<long>		s;
+
+	void push(long v)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		s.push(v);
+	}
+
+	bool try_pop(long& out)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		if (s.empty())
+			return false;
+		out = s.top();
+		s.pop();
+		return true;
+	}
+};
+
+// Each thread takes an item and gives it back, as workers do with a free list
+template <class Stack>
+static double run(int threads, int ops, long long& sink) {
+	Stack					s;
+	std::vector<std::thread>	pool;
+	std::vector<long long>		sums(threads);
+
+	for (long i = 0; i < threads * 16; i++)
+		s.push(i);
+	double start = now();
+	for (int t = 0; t < threads; t++)
+		pool.push_back(std::thread([&s, &sums, t, ops] {
+			long		v;
+			long long	sum = 0;
+			for (int i = 0; i < ops; i++)
+			{
+				if (s.try_pop(v))
+				{
+					sum += v;
+					s.push(v);
+				}
+			}
+			sums[t] = sum;
+		}));
+	for (int t = 0; t < threads; t++)
+		pool[t].join();
+	double elapsed = now() - start;
+	for (int t = 0; t < threads; t++)
+		sink += sums[t];
+	return elapsed;
+}
+
+int main(int argc, char** argv) {
+	int			ops = argc > 1 ? atoi(argv[1]) : 1000000;
+	int			max_threads = argc > 2 ? atoi(argv[2]) : std::thread::hardware_concurrency();
+	long long	sink = 0;
+
+	if (max_threads < 1)
+		max_threads = 1;
+	for (int threads = 1; threads <= max_threads; threads *= 2)
+	{
+		double t_lock = run<locked_stack>(threads, ops, sink);
+		double t_free = run<ft::concurrent_stack<long> >(threads, ops, sink);
+		double total = 2.0 * threads * ops / 1e6;
+		std::cout << threads << " threads: mutex + ft::stack " << total / t_lock
+			<< " Mops/s | ft::concurrent_stack " << total / t_free << " Mops/s" << std::endl;
+		if (threads < max_threads && threads * 2 > max_threads)
+			threads = max_threads / 2;
+	}
+	std::cout << "(" << sink << ")" << std::endl;
+	return 0;
+}
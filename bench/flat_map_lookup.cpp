@@ -0,0 +1,69 @@
+// Lookup throughput: ft::flat_map vs ft::map vs std::map
+// c++ -O2 -std=c++11 bench/flat_map_lookup.cpp -o flat_map_lookup && ./flat_map_lookup [size...]
+#include <iostream>
+#include <map>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+#include "../flat_map.hpp"
+
+#define LOOKUPS 2000000
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template <class Map>
+static double run_lookups(const Map& m, const int* keys, long long& sink) {
+	double start = now();
+	for (int i = 0; i < LOOKUPS; i++)
+		sink += m.find(keys[i]) != m.end();
+	return now() - start;
+}
+
+static void bench(int size) {
+	ft::vector<int>			ks;
+	ft::vector<int>			vs;
+	ft::map<int, int>		ft_map;
+	std::map<int, int>		std_map;
+	ft::flat_map<int, int>	flat;
+
+	for (int i = 0; i < size; i++)
+	{
+		ks.push_back(i * 2);
+		vs.push_back(i);
+		ft_map.insert(ft::make_pair(i * 2, i));
+		std_map.insert(std::make_pair(i * 2, i));
+	}
+	flat.adopt_sorted(ks, vs);
+
+	int* keys = new int[LOOKUPS];
+	for (int i = 0; i < LOOKUPS; i++)
+		keys[i] = rand() % (size * 2);
+
+	long long sink = 0;
+	double t_flat = run_lookups(flat, keys, sink);
+	double t_ft = run_lookups(ft_map, keys, sink);
+	double t_std = run_lookups(std_map, keys, sink);
+	std::cout << "size " << size << " (Mlookups/s): flat_map " << LOOKUPS / t_flat / 1e6
+		<< " | ft::map " << LOOKUPS / t_ft / 1e6
+		<< " | std::map " << LOOKUPS / t_std / 1e6 << " (" << sink << ")" << std::endl;
+	delete[] keys;
+}
+
+int main(int argc, char** argv) {
+	srand(42);
+	if (argc < 2)
+	{
+		bench(1000);
+		bench(100000);
+		bench(1000000);
+		bench(10000000);
+	}
+	for (int i = 1; i < argc; i++)
+		bench(atoi(argv[i]));
+	return 0;
+}
@@ -0,0 +1,60 @@
+// Range query benchmark: ft::map vs std::map lower_bound / upper_bound / equal_range
+// c++ -O2 -std=c++11 bench/map_bounds.cpp -o map_bounds && ./map_bounds [size...]
+#include <iostream>
+#include <map>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+
+#define QUERIES 1000000
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template <class Map>
+static double run_queries(const Map& m, const int* keys, long long& sink) {
+	double start = now();
+	for (int i = 0; i < QUERIES; i++)
+	{
+		sink += m.lower_bound(keys[i])->first;
+		sink += m.upper_bound(keys[i]) == m.end();
+		sink += m.equal_range(keys[i]).first == m.end();
+	}
+	return now() - start;
+}
+
+static void bench(int size) {
+	ft::map<int, int>	ft_map;
+	std::map<int, int>	std_map;
+
+	for (int i = 0; i < size; i++)
+	{
+		ft_map.insert(ft::make_pair(i * 2, i));
+		std_map.insert(std::make_pair(i * 2, i));
+	}
+	int* keys = new int[QUERIES];
+	for (int i = 0; i < QUERIES; i++)
+		keys[i] = rand() % (size * 2 - 1);
+
+	long long sink = 0;
+	double t_ft = run_queries(ft_map, keys, sink);
+	double t_std = run_queries(std_map, keys, sink);
+	std::cout << "size " << size << ": ft " << t_ft << "s | std " << t_std << "s (" << sink << ")" << std::endl;
+	delete[] keys;
+}
+
+int main(int argc, char** argv) {
+	srand(42);
+	if (argc < 2)
+	{
+		bench(1000000);
+		bench(10000000);
+	}
+	for (int i = 1; i < argc; i++)
+		bench(atoi(argv[i]));
+	return 0;
+}
@@ -0,0 +1,79 @@
+// Storage engine benchmark: ft::map on the red-black tree vs the B+ tree policy
+// point lookups (find) and range scans (lower_bound + 100 steps)
+// c++ -O2 -std=c++11 bench/map_btree.cpp -o map_btree && ./map_btree [size...]
+#include <iostream>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+
+#define QUERIES 1000000
+#define SCANS 100000
+#define SCAN_LEN 100
+
+typedef ft::map<int, int>																	rb_map;
+typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+				ft::bplus_tree_policy<> >													bp_map;
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template <class Map>
+static double run_finds(const Map& m, const int* keys, long long& sink) {
+	double start = now();
+	for (int i = 0; i < QUERIES; i++)
+		sink += m.find(keys[i]) != m.end();
+	return now() - start;
+}
+
+template <class Map>
+static double run_scans(const Map& m, const int* keys, long long& sink) {
+	double start = now();
+	for (int i = 0; i < SCANS; i++)
+	{
+		typename Map::const_iterator it = m.lower_bound(keys[i]);
+		for (int j = 0; j < SCAN_LEN && it != m.end(); j++, ++it)
+			sink += it->second;
+	}
+	return now() - start;
+}
+
+static void bench(int size) {
+	rb_map	rb;
+	bp_map	bp;
+
+	for (int i = 0; i < size; i++)
+	{
+		int k = rand() % (size * 2);
+		rb.insert(ft::make_pair(k, i));
+		bp.insert(ft::make_pair(k, i));
+	}
+	int* keys = new int[QUERIES];
+	for (int i = 0; i < QUERIES; i++)
+		keys[i] = rand() % (size * 2);
+
+	long long sink = 0;
+	double f_rb = run_finds(rb, keys, sink);
+	double f_bp = run_finds(bp, keys, sink);
+	double s_rb = run_scans(rb, keys, sink);
+	double s_bp = run_scans(bp, keys, sink);
+	std::cout << "size " << size << ": find rb " << f_rb << "s | b+ " << f_bp
+		<< "s, scan rb " << s_rb << "s | b+ " << s_bp << "s (" << sink << ")" << std::endl;
+	delete[] keys;
+}
+
+int main(int argc, char** argv) {
+	srand(42);
+	if (argc < 2)
+	{
+		bench(100000);
+		bench(1000000);
+		bench(10000000);
+	}
+	for (int i = 1; i < argc; i++)
+		bench(atoi(argv[i]));
+	return 0;
+}
@@ -0,0 +1,48 @@
+// Building main.cpp's map_int from random pairs: insert loop vs map::build_parallel
+// c++ -O2 -std=c++11 -pthread bench/map_build_parallel.cpp -o map_build_parallel && ./map_build_parallel [size] [max_threads]
+#include <iostream>
+#include <thread>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+#include "../vector.hpp"
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char** argv) {
+	typedef ft::vector<ft::pair<int, int> >::iterator	src_iterator;
+	int								size = argc > 1 ? atoi(argv[1]) : 1 << 20;
+	unsigned						max_threads = argc > 2 ? atoi(argv[2]) : std::thread::hardware_concurrency();
+	ft::vector<ft::pair<int, int> >	src;
+
+	srand(42);
+	src.reserve(size);
+	for (int i = 0; i < size; i++)
+	{
+		int k = rand();
+		src.push_back(ft::make_pair(k, rand()));
+	}
+
+	double start = now();
+	ft::map<int, int> ref;
+	for (src_iterator it = src.begin(); it != src.end(); it++)
+		ref.insert(*it);
+	std::cout << "size " << size << ": insert " << now() - start << "s" << std::endl;
+
+	if (max_threads < 1)
+		max_threads = 1;
+	for (unsigned threads = 1; threads <= max_threads; threads *= 2)
+	{
+		start = now();
+		ft::map<int, int> m;
+		m.build_parallel(src.begin(), src.end(), threads);
+		std::cout << "  build_parallel, " << threads << " threads: " << now() - start << "s"
+			<< (m == ref ? "" : " (MISMATCH)") << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,49 @@
+// Sorted bulk load benchmark: element-wise insert vs linear-time build
+// c++ -O2 -std=c++11 bench/map_bulk_load.cpp -o map_bulk_load && ./map_bulk_load [size...]
+#include <iostream>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+#include "../vector.hpp"
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench(int size) {
+	typedef ft::vector<ft::pair<int, int> >::iterator	src_iterator;
+	ft::vector<ft::pair<int, int> >	src;
+
+	src.reserve(size);
+	for (int i = 0; i < size; i++)
+		src.push_back(ft::make_pair(i * 2, i));
+
+	double start = now();
+	{
+		ft::map<int, int> m;
+		for (src_iterator it = src.begin(); it != src.end(); it++)
+			m.insert(*it);
+		std::cout << "size " << size << ": insert " << now() - start << "s";
+	}
+	start = now();
+	{
+		ft::map<int, int> m(src.begin(), src.end());
+		std::cout << " | detected " << now() - start << "s";
+	}
+	start = now();
+	{
+		ft::map<int, int> m(ft::sorted_unique, src.begin(), src.end());
+		std::cout << " | sorted_unique " << now() - start << "s" << std::endl;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2)
+		bench(10000000);
+	for (int i = 1; i < argc; i++)
+		bench(atoi(argv[i]));
+	return 0;
+}
@@ -0,0 +1,86 @@
+// main.cpp's lookup pattern: a map filled with COUNT random pairs, then rounds of
+// 10,000 random probes, one find at a time vs map::find_batch
+// c++ -O2 -std=c++11 bench/map_find_batch.cpp -o map_find_batch && ./map_find_batch [count] [rounds]
+#include <iostream>
+#include <vector>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+
+#define PROBES 10000
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template <class Map>
+static double run_find(const Map& m, const std::vector<int>& keys, int rounds, long long& sink) {
+	double start = now();
+	for (int r = 0; r < rounds; r++)
+		for (int i = 0; i < PROBES; i++)
+		{
+			typename Map::const_iterator it = m.find(keys[r * PROBES + i]);
+			if (it != m.end())
+				sink += it->second;
+		}
+	return now() - start;
+}
+
+template <class Map>
+static double run_batch(const Map& m, const std::vector<int>& keys, int rounds, long long& sink) {
+	std::vector<typename Map::const_iterator> found(PROBES);
+
+	double start = now();
+	for (int r = 0; r < rounds; r++)
+	{
+		m.find_batch(keys.begin() + r * PROBES, keys.begin() + (r + 1) * PROBES, found.begin());
+		for (int i = 0; i < PROBES; i++)
+			if (found[i] != m.end())
+				sink += found[i]->second;
+	}
+	return now() - start;
+}
+
+template <class Map>
+static void bench(const char* name, int count, int rounds) {
+	Map					m;
+	std::vector<int>	inserted;
+	std::vector<int>	random;
+	std::vector<int>	present;
+
+	srand(42);
+	for (int i = 0; i < count; i++)
+	{
+		int k = rand();
+		m.insert(ft::make_pair(k, rand()));
+		inserted.push_back(k);
+	}
+	for (int i = 0; i < rounds * PROBES; i++)
+	{
+		random.push_back(rand());
+		present.push_back(inserted[rand() % count]);
+	}
+
+	long long sink = 0;
+	double t_find = run_find(m, random, rounds, sink);
+	double t_batch = run_batch(m, random, rounds, sink);
+	double t_find_hit = run_find(m, present, rounds, sink);
+	double t_batch_hit = run_batch(m, present, rounds, sink);
+	std::cout << name << " " << m.size() << " keys, " << rounds << " x " << PROBES << " probes" << std::endl
+		<< "  random keys:  find " << t_find << "s | find_batch " << t_batch << "s" << std::endl
+		<< "  present keys: find " << t_find_hit << "s | find_batch " << t_batch_hit << "s"
+		<< " (" << sink << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	int count = argc > 1 ? atoi(argv[1]) : 1 << 20;
+	int rounds = argc > 2 ? atoi(argv[2]) : 100;
+
+	bench<ft::map<int, int> >("rb tree", count, rounds);
+	bench<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::bplus_tree_policy<> > >("b+ tree", count, rounds);
+	return 0;
+}
@@ -0,0 +1,89 @@
+// Full and range scans of a map filled with COUNT random pairs: summing the mapped
+// values through the iterators vs map::for_each / map::for_each_range
+// c++ -O2 -std=c++11 bench/map_for_each.cpp -o map_for_each && ./map_for_each [count] [rounds]
+#include <iostream>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct Sum
+{
+	long long	total;
+	Sum() : total(0) {}
+	void operator()(const ft::pair<const int, int>& p) { total += p.second; }
+};
+
+template <class Map>
+static double run_iterate(const Map& m, int lo, int hi, int rounds, long long& sink) {
+	double start = now();
+	for (int r = 0; r < rounds; r++)
+	{
+		typename Map::const_iterator end = m.lower_bound(hi);
+		for (typename Map::const_iterator it = m.lower_bound(lo); it != end; ++it)
+			sink += it->second;
+	}
+	return now() - start;
+}
+
+template <class Map>
+static double run_for_each(const Map& m, int lo, int hi, int rounds, long long& sink) {
+	double start = now();
+	for (int r = 0; r < rounds; r++)
+		sink += m.for_each_range(lo, hi, Sum()).total;
+	return now() - start;
+}
+
+template <class Map>
+static double run_full_iterate(const Map& m, int rounds, long long& sink) {
+	double start = now();
+	for (int r = 0; r < rounds; r++)
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+			sink += it->second;
+	return now() - start;
+}
+
+template <class Map>
+static double run_full_for_each(const Map& m, int rounds, long long& sink) {
+	double start = now();
+	for (int r = 0; r < rounds; r++)
+		sink += m.for_each(Sum()).total;
+	return now() - start;
+}
+
+template <class Map>
+static void bench(const char* name, int count, int rounds) {
+	Map	m;
+
+	srand(42);
+	for (int i = 0; i < count; i++)
+		m.insert(ft::make_pair(rand(), rand()));
+
+	long long sink = 0;
+	int lo = RAND_MAX / 4;
+	int hi = RAND_MAX / 4 * 3;
+	double t_it = run_full_iterate(m, rounds, sink);
+	double t_fe = run_full_for_each(m, rounds, sink);
+	double t_it_range = run_iterate(m, lo, hi, rounds, sink);
+	double t_fe_range = run_for_each(m, lo, hi, rounds, sink);
+	std::cout << name << " " << m.size() << " keys, " << rounds << " scans" << std::endl
+		<< "  whole map:  iterators " << t_it << "s | for_each " << t_fe << "s (x" << t_it / t_fe << ")" << std::endl
+		<< "  middle 50%: iterators " << t_it_range << "s | for_each_range " << t_fe_range << "s (x"
+		<< t_it_range / t_fe_range << ")" << " (" << sink << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	int count = argc > 1 ? atoi(argv[1]) : 1 << 20;
+	int rounds = argc > 2 ? atoi(argv[2]) : 20;
+
+	bench<ft::map<int, int> >("rb tree", count, rounds);
+	bench<ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >,
+		ft::bplus_tree_policy<> > >("b+ tree", count, rounds);
+	return 0;
+}
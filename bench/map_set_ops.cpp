@@ -0,0 +1,65 @@
+// Shard rebalancing: cut a map at a key and merge a small map into a large one,
+// element by element vs split / join / merge
+// c++ -O2 -std=c++11 bench/map_set_ops.cpp -o map_set_ops && ./map_set_ops [size] [small]
+#include <iostream>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+typedef ft::map<int, int>	map_type;
+
+int main(int argc, char** argv) {
+	int			size = argc > 1 ? atoi(argv[1]) : 1 << 20;
+	int			small = argc > 2 ? atoi(argv[2]) : 1000;
+	map_type	big;
+	map_type	other;
+
+	srand(42);
+	for (int i = 0; i < size; i++)
+		big.insert(ft::make_pair(rand(), i));
+	for (int i = 0; i < small; i++)
+		other.insert(ft::make_pair(rand(), i));
+	int cut = big.nth(big.size() / 2)->first;
+
+	// Cut at the median and glue back
+	double start = now();
+	{
+		map_type upper(big.lower_bound(cut), big.end());
+		big.erase(big.lower_bound(cut), big.end());
+		for (map_type::iterator it = upper.begin(); it != upper.end(); it++)
+			big.insert(big.end(), *it);
+	}
+	double t_elem_split = now() - start;
+	start = now();
+	{
+		map_type upper;
+		big.split(cut, upper);
+		big.join(upper);
+	}
+	double t_split = now() - start;
+
+	// Merge a small shard into the big one
+	map_type copy1(other);
+	map_type copy2(other);
+	start = now();
+	for (map_type::iterator it = copy1.begin(); it != copy1.end(); it++)
+		big.insert(*it);
+	double t_elem_merge = now() - start;
+	for (map_type::iterator it = copy1.begin(); it != copy1.end(); it++)
+		big.erase(it->first);
+	start = now();
+	big.merge(copy2);
+	double t_merge = now() - start;
+
+	std::cout << "size " << big.size() << ", small " << small << std::endl
+		<< "  cut + glue: erase/insert " << t_elem_split << "s | split/join " << t_split << "s" << std::endl
+		<< "  merge small: insert " << t_elem_merge << "s | merge " << t_merge << "s" << std::endl;
+	return 0;
+}
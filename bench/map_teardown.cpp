@@ -0,0 +1,72 @@
+// Teardown cost of a map of COUNT pairs: destructor, clear(), erase(begin(), end())
+// and assignment of a small map, with std::allocator and with ft::pool_allocator
+// (whose slabs are released in bulk for trivially destructible pairs)
+// c++ -O2 -std=c++11 bench/map_teardown.cpp -o map_teardown && ./map_teardown [count]
+#include <iostream>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../map.hpp"
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template <class Map>
+static void fill(Map& m, int count) {
+	srand(42);
+	for (int i = 0; i < count; i++)
+		m.insert(ft::make_pair(rand(), i));
+}
+
+template <class Map>
+static void bench(const char* name, int count) {
+	double	t_dtor;
+	double	t_clear;
+	double	t_erase;
+	double	t_assign;
+
+	{
+		Map* m = new Map;
+		fill(*m, count);
+		double start = now();
+		delete m;
+		t_dtor = now() - start;
+	}
+	{
+		Map m;
+		fill(m, count);
+		double start = now();
+		m.clear();
+		t_clear = now() - start;
+	}
+	{
+		Map m;
+		fill(m, count);
+		double start = now();
+		m.erase(m.begin(), m.end());
+		t_erase = now() - start;
+	}
+	{
+		Map m;
+		Map small;
+		fill(m, count);
+		fill(small, 10);
+		double start = now();
+		m = small;
+		t_assign = now() - start;
+	}
+	std::cout << name << " " << count << " pairs" << std::endl
+		<< "  destructor " << t_dtor << "s | clear " << t_clear << "s | erase(begin, end) " << t_erase
+		<< "s | operator= (10 pairs) " << t_assign << "s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	int count = argc > 1 ? atoi(argv[1]) : 1 << 22;
+
+	bench<ft::map<int, int> >("std::allocator", count);
+	bench<ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > > >("pool_allocator", count);
+	return 0;
+}
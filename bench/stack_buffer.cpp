@@ -0,0 +1,63 @@
+// ft::stack of 4 KiB Buffers over ft::vector, ft::deque and std::deque:
+// push COUNT elements, read the top, pop them all
+// c++ -O2 -std=c++11 bench/stack_buffer.cpp -o stack_buffer && ./stack_buffer [count...]
+#include <iostream>
+#include <deque>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../stack.hpp"
+#include "../deque.hpp"
+
+struct Buffer
+{
+	int		idx;
+	char	buff[4096];
+};
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template <class Stack>
+static double run(int count, long long& sink) {
+	double start = now();
+	{
+		Stack s;
+		Buffer b = Buffer();
+		for (int i = 0; i < count; i++)
+		{
+			b.idx = i;
+			s.push(b);
+		}
+		while (!s.empty())
+		{
+			sink += s.top().idx;
+			s.pop();
+		}
+	}
+	return now() - start;
+}
+
+static void bench(int count) {
+	long long sink = 0;
+	double t_vec = run<ft::stack<Buffer, ft::vector<Buffer> > >(count, sink);
+	double t_ft = run<ft::stack<Buffer, ft::deque<Buffer> > >(count, sink);
+	double t_std = run<ft::stack<Buffer, std::deque<Buffer> > >(count, sink);
+	std::cout << "Buffer x" << count << ": ft::vector " << t_vec << "s | ft::deque " << t_ft
+		<< "s | std::deque " << t_std << "s (" << sink << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2)
+	{
+		bench(10000);
+		bench(100000);
+		bench(500000);
+	}
+	for (int i = 1; i < argc; i++)
+		bench(atoi(argv[i]));
+	return 0;
+}
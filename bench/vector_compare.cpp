@@ -0,0 +1,91 @@
+// Comparison benchmark: operator== and operator< of ft::vector<char> / ft::vector<int>,
+// byte kernels vs the element-by-element loop, for buffers from 16 B to 64 MiB
+// that differ only in their last element (the whole buffer has to be read)
+// c++ -O2 -std=c++11 bench/vector_compare.cpp -o vector_compare && ./vector_compare [bytes...]
+#include <iostream>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../vector.hpp"
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// What operator== and operator< did before the byte kernels
+template <class Vec>
+static __attribute__((noinline)) bool loop_equal(const Vec& a, const Vec& b) {
+	if (a.size() != b.size())
+		return false;
+	for (size_t i = 0; i < a.size(); i++)
+		if (a[i] != b[i]) return false;
+	return true;
+}
+
+template <class Vec>
+static __attribute__((noinline)) bool loop_less(const Vec& a, const Vec& b) {
+	return ft::_lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+template <class Vec>
+static __attribute__((noinline)) bool kernel_equal(const Vec& a, const Vec& b) {
+	return a == b;
+}
+
+template <class Vec>
+static __attribute__((noinline)) bool kernel_less(const Vec& a, const Vec& b) {
+	return a < b;
+}
+
+template <class Vec, class F>
+static double run(F f, const Vec& a, const Vec& b, int repeat, long long& sink) {
+	double start = now();
+	for (int r = 0; r < repeat; r++)
+		sink += f(a, b);
+	return (now() - start) / repeat;
+}
+
+template <class T>
+static void bench(const char* label, size_t bytes) {
+	typedef ft::vector<T>	Vec;
+	size_t		n = bytes / sizeof(T) ? bytes / sizeof(T) : 1;
+	Vec			a;
+	long long	sink = 0;
+	int			repeat = static_cast<int>((1 << 28) / (bytes + 64)) + 1;
+
+	for (size_t i = 0; i < n; i++)
+		a.push_back(static_cast<T>(rand()));
+	Vec	b(a);
+	b[n - 1] = static_cast<T>(b[n - 1] + 1);
+
+	double le = run(loop_equal<Vec>, a, b, repeat, sink);
+	double ke = run(kernel_equal<Vec>, a, b, repeat, sink);
+	double ll = run(loop_less<Vec>, a, b, repeat, sink);
+	double kl = run(kernel_less<Vec>, a, b, repeat, sink);
+
+	std::cout << label << " " << n * sizeof(T) << " B" << std::endl;
+	std::cout << "  ==  loop " << le * 1e9 << "ns  kernel " << ke * 1e9 << "ns  x" << le / ke << std::endl;
+	std::cout << "  <   loop " << ll * 1e9 << "ns  kernel " << kl * 1e9 << "ns  x" << ll / kl << std::endl;
+	std::cout << "  (" << sink << ")" << std::endl;
+}
+
+int main(int ac, char** av) {
+	if (ac == 1)
+	{
+		for (size_t bytes = 16; bytes <= (64u << 20); bytes *= 16)
+		{
+			bench<char>("vector<char>", bytes);
+			bench<int>("vector<int>", bytes);
+		}
+		bench<char>("vector<char>", 64u << 20);
+		bench<int>("vector<int>", 64u << 20);
+	}
+	for (int i = 1; i < ac; i++)
+	{
+		bench<char>("vector<char>", atoi(av[i]));
+		bench<int>("vector<int>", atoi(av[i]));
+	}
+	return 0;
+}
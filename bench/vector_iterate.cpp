@@ -0,0 +1,108 @@
+// Iterator overhead: summing an ft::vector<int> through its iterators vs through
+// a raw pointer, plus map traversal through the tree iterators.
+// The static_asserts check that the iterators are a bare pointer, copied in registers.
+// c++ -O3 -std=c++11 -fopt-info-vec-optimized bench/vector_iterate.cpp -o vector_iterate 2>&1 | grep "loop vectorized"
+// ./vector_iterate [size...]
+#include <iostream>
+#include <type_traits>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../vector.hpp"
+#include "../map.hpp"
+
+#define REPEAT 200
+
+typedef ft::vector<int>		vec_type;
+typedef ft::map<int, int>	map_type;
+
+static_assert(sizeof(vec_type::iterator) == sizeof(int*), "vector iterator is not pointer-sized");
+static_assert(std::is_trivially_copyable<vec_type::iterator>::value, "vector iterator is not trivially copyable");
+static_assert(std::is_trivially_copyable<vec_type::const_iterator>::value, "vector const_iterator is not trivially copyable");
+static_assert(ft::is_contiguous_iterator<vec_type::iterator>::value, "vector iterator is not contiguous");
+static_assert(sizeof(map_type::iterator) == sizeof(void*), "map iterator is not pointer-sized");
+static_assert(std::is_trivially_copyable<map_type::iterator>::value, "map iterator is not trivially copyable");
+static_assert(std::is_trivially_copyable<map_type::const_iterator>::value, "map const_iterator is not trivially copyable");
+
+// Keeps the compiler from hoisting the pure sums out of the timing loops
+static inline void clobber() { asm volatile("" ::: "memory"); }
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static __attribute__((noinline)) long long sum_iterator(const vec_type& v) {
+	long long s = 0;
+	for (vec_type::const_iterator it = v.begin(); it != v.end(); ++it)
+		s += *it;
+	return s;
+}
+
+static __attribute__((noinline)) long long sum_pointer(const int* p, std::size_t n) {
+	long long s = 0;
+	for (const int* end = p + n; p != end; ++p)
+		s += *p;
+	return s;
+}
+
+static __attribute__((noinline)) long long sum_map(const map_type& m) {
+	long long s = 0;
+	for (map_type::const_iterator it = m.begin(); it != m.end(); ++it)
+		s += it->second;
+	return s;
+}
+
+static void bench(int size) {
+	vec_type	v;
+	map_type	m;
+	long long	sink = 0;
+
+	for (int i = 0; i < size; i++)
+		v.push_back(rand() % 1000);
+	for (int i = 0; i < size; i++)
+		m.insert(ft::make_pair(i, v[i]));
+
+	double start = now();
+	for (int r = 0; r < REPEAT; r++)
+	{
+		clobber();
+		sink += sum_iterator(v);
+	}
+	double it_time = now() - start;
+
+	start = now();
+	for (int r = 0; r < REPEAT; r++)
+	{
+		clobber();
+		sink += sum_pointer(&v[0], v.size());
+	}
+	double ptr_time = now() - start;
+
+	start = now();
+	for (int r = 0; r < REPEAT / 10; r++)
+	{
+		clobber();
+		sink += sum_map(m);
+	}
+	double map_time = now() - start;
+
+	std::cout << "size " << size << std::endl;
+	std::cout << "  vector iterator " << it_time << "s" << std::endl;
+	std::cout << "  raw pointer     " << ptr_time << "s (x" << it_time / ptr_time << ")" << std::endl;
+	std::cout << "  map iterator    " << map_time << "s" << std::endl;
+	std::cout << "  (" << sink << ")" << std::endl;
+}
+
+int main(int ac, char** av) {
+	if (ac == 1)
+	{
+		bench(1000);
+		bench(100000);
+		bench(1000000);
+	}
+	for (int i = 1; i < ac; i++)
+		bench(atoi(av[i]));
+	return 0;
+}
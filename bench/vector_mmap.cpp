@@ -0,0 +1,56 @@
+// Filling a multi-GiB ft::vector<Buffer>: std::allocator vs ft::mmap_allocator
+// (huge page hint, growth by mremap instead of copy)
+// c++ -O2 -std=c++11 bench/vector_mmap.cpp -o vector_mmap && ./vector_mmap [count...]
+#include <iostream>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../vector.hpp"
+#include "../utils/mmap_allocator.hpp"
+
+struct Buffer
+{
+	int		idx;
+	char	buff[4096];
+};
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template <class Vec>
+static double fill(int count, long long& sink) {
+	double start = now();
+	Vec v;
+	for (int i = 0; i < count; i++)
+	{
+		Buffer b;
+		b.idx = i;
+		v.push_back(b);
+	}
+	for (int i = 0; i < count; i++)
+		sink += v[rand() % count].idx;
+	return now() - start;
+}
+
+static void bench(int count) {
+	long long sink = 0;
+	double t_std = fill<ft::vector<Buffer> >(count, sink);
+	double t_mmap = fill<ft::vector<Buffer, ft::mmap_allocator<Buffer> > >(count, sink);
+	std::cout << "Buffer x" << count << ": std::allocator " << t_std << "s | mmap_allocator " << t_mmap
+		<< "s (" << sink << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	srand(42);
+	if (argc < 2)
+	{
+		bench(50000);
+		bench(250000);
+	}
+	for (int i = 1; i < argc; i++)
+		bench(atoi(argv[i]));
+	return 0;
+}
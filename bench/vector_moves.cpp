@@ -0,0 +1,106 @@
+// Growth cost of ft::vector with heap-owning elements: copy-only relocation
+// (the old behaviour, forced through a wrapper whose move is a copy) vs moves
+// counts every global operator new while filling the vector
+// c++ -O2 -std=c++11 bench/vector_moves.cpp -o vector_moves && ./vector_moves [count...]
+#include <iostream>
+#include <string>
+#include <new>
+#include <cstdlib>
+#include <ctime>
+
+#include "../vector.hpp"
+
+static long g_allocs = 0;
+
+void* operator new(std::size_t n) {
+	g_allocs++;
+	void* p = malloc(n ? n : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, std::size_t) noexcept { free(p); }
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct Record
+{
+	char				header[256];
+	std::string			name;
+	ft::vector<int>		samples;
+
+	Record(int i) : name(64, 'a' + i % 26), samples(16, i) { header[0] = 0; }
+};
+
+// Declaring the copy constructor hides the implicit move: every relocation copies
+template <class T>
+struct copy_only
+{
+	T	value;
+
+	copy_only(T&& x) : value(std::move(x)) {}
+	copy_only(const copy_only& x) : value(x.value) {}
+	copy_only& operator=(const copy_only& x) { value = x.value; return *this; }
+};
+
+template <class T, class Make>
+static void fill(const char* label, int count, Make make) {
+	long	allocs = g_allocs;
+	double	start = now();
+	{
+		ft::vector<copy_only<T> > v;
+		for (int i = 0; i < count; i++)
+			v.push_back(copy_only<T>(make(i)));
+	}
+	double	t_copy = now() - start;
+	long	a_copy = g_allocs - allocs;
+
+	allocs = g_allocs;
+	start = now();
+	{
+		ft::vector<T> v;
+		for (int i = 0; i < count; i++)
+			v.push_back(make(i));
+	}
+	double	t_move = now() - start;
+	long	a_move = g_allocs - allocs;
+
+	std::cout << label << " x" << count << ": copy " << a_copy << " allocs " << t_copy
+		<< "s | move " << a_move << " allocs " << t_move << "s" << std::endl;
+}
+
+static std::string make_string(int i) { return std::string(48, 'a' + i % 26); }
+static Record make_record(int i) { return Record(i); }
+
+static void emplace(int count) {
+	long	allocs = g_allocs;
+	{
+		ft::vector<Record> v;
+		for (int i = 0; i < count; i++)
+			v.emplace_back(i);
+	}
+	std::cout << "record emplace_back x" << count << ": " << g_allocs - allocs << " allocs" << std::endl;
+}
+
+static void bench(int count) {
+	fill<std::string>("string", count, make_string);
+	fill<Record>("record", count, make_record);
+	emplace(count);
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2)
+	{
+		bench(100000);
+		bench(1000000);
+	}
+	for (int i = 1; i < argc; i++)
+		bench(atoi(argv[i]));
+	return 0;
+}
@@ -0,0 +1,104 @@
+// Bulk operation benchmark: ft::vector vs std::vector for PODs
+// insert(pos, val), insert(pos, n, val), erase(first, last), copy constructor, operator=
+// c++ -O2 -std=c++11 bench/vector_ops.cpp -o vector_ops && ./vector_ops [size...]
+#include <iostream>
+#include <vector>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../vector.hpp"
+
+#define REPEAT 200
+
+struct Buffer
+{
+	int		idx;
+	char	buff[4096];
+};
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+template <class Vec>
+static double insert_one(Vec& v, const typename Vec::value_type& val) {
+	double start = now();
+	for (int i = 0; i < REPEAT; i++)
+		v.insert(v.begin() + v.size() / 2, val);
+	return now() - start;
+}
+
+template <class Vec>
+static double insert_n(Vec& v, const typename Vec::value_type& val) {
+	double start = now();
+	for (int i = 0; i < REPEAT; i++)
+		v.insert(v.begin() + v.size() / 3, 16, val);
+	return now() - start;
+}
+
+template <class Vec>
+static double erase_range(Vec& v) {
+	double start = now();
+	for (int i = 0; i < REPEAT && v.size() > 20; i++)
+		v.erase(v.begin() + v.size() / 4, v.begin() + v.size() / 4 + 17);
+	return now() - start;
+}
+
+template <class Vec>
+static double copy(const Vec& v, long long& sink) {
+	double start = now();
+	for (int i = 0; i < REPEAT / 10; i++)
+	{
+		Vec c(v);
+		sink += c.size();
+	}
+	return now() - start;
+}
+
+template <class Vec>
+static double assign(const Vec& v, long long& sink) {
+	Vec c(v);
+	double start = now();
+	for (int i = 0; i < REPEAT / 10; i++)
+	{
+		c = v;
+		sink += c.size();
+	}
+	return now() - start;
+}
+
+template <class T>
+static void bench(const char* label, int size, const T& val) {
+	ft::vector<T>	a(size, val);
+	std::vector<T>	b(size, val);
+	long long		sink = 0;
+
+	a.reserve(size + REPEAT * 20);
+	b.reserve(size + REPEAT * 20);
+	std::cout << label << " size " << size << std::endl;
+	std::cout << "  insert(pos, val)    ft " << insert_one(a, val) << "s | std " << insert_one(b, val) << "s" << std::endl;
+	std::cout << "  insert(pos, n, val) ft " << insert_n(a, val) << "s | std " << insert_n(b, val) << "s" << std::endl;
+	std::cout << "  erase(first, last)  ft " << erase_range(a) << "s | std " << erase_range(b) << "s" << std::endl;
+	std::cout << "  copy constructor    ft " << copy(a, sink) << "s | std " << copy(b, sink) << "s" << std::endl;
+	std::cout << "  operator=           ft " << assign(a, sink) << "s | std " << assign(b, sink) << "s (" << sink << ")" << std::endl;
+}
+
+static void bench_all(int size) {
+	Buffer buf = Buffer();
+	bench<char>("char", size, 'x');
+	bench<int>("int", size, 42);
+	bench<Buffer>("Buffer", size / 256 ? size / 256 : 1, buf);
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2)
+	{
+		bench_all(100000);
+		bench_all(1000000);
+	}
+	for (int i = 1; i < argc; i++)
+		bench_all(atoi(argv[i]));
+	return 0;
+}
@@ -0,0 +1,83 @@
+// Sizing a large ft::vector: push_back loop vs resize vs resize_default_init
+// vs reserve_and_append, for 4 KiB Buffer elements and doubles
+// c++ -O2 -std=c++11 bench/vector_resize.cpp -o vector_resize && ./vector_resize [count...]
+#include <iostream>
+#include <ctime>
+#include <stdlib.h>
+
+#include "../vector.hpp"
+
+struct Buffer
+{
+	int		idx;
+	char	buff[4096];
+};
+
+static double now() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+struct make_double
+{
+	double	x;
+	make_double() : x(0) {}
+	double operator()() { return x += 0.5; }
+};
+
+template <class T>
+static void bench(const char* label, int count) {
+	long long sink = 0;
+
+	double start = now();
+	{
+		ft::vector<T> v;
+		for (int i = 0; i < count; i++)
+			v.push_back(T());
+		sink += v.size();
+	}
+	double t_push = now() - start;
+
+	start = now();
+	{
+		ft::vector<T> v;
+		v.resize(count);
+		sink += v.size();
+	}
+	double t_resize = now() - start;
+
+	start = now();
+	{
+		ft::vector<T> v;
+		v.resize_default_init(count);
+		sink += v.size();
+	}
+	double t_default = now() - start;
+
+	std::cout << label << " x" << count << ": push_back " << t_push << "s | resize " << t_resize
+		<< "s | resize_default_init " << t_default << "s (" << sink << ")" << std::endl;
+}
+
+static void bench_append(int count) {
+	make_double gen;
+	double start = now();
+	ft::vector<double> v;
+	v.reserve_and_append(count, gen);
+	std::cout << "double x" << count << ": reserve_and_append " << now() - start << "s (" << v.back() << ")" << std::endl;
+}
+
+int main(int argc, char** argv) {
+	if (argc < 2)
+	{
+		bench<Buffer>("Buffer", 100000);
+		bench<double>("double", 50000000);
+		bench_append(50000000);
+	}
+	for (int i = 1; i < argc; i++)
+	{
+		bench<Buffer>("Buffer", atoi(argv[i]));
+		bench_append(atoi(argv[i]));
+	}
+	return 0;
+}
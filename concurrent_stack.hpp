@@ -0,0 +1,242 @@
+#pragma once
+
+# include <atomic>
+# include <cstddef>
+# include <memory>
+# include <new>
+# include <utility>
+# include <stdint.h>
+
+namespace ft
+{
+	// Lock-free LIFO shared between threads (Treiber stack).
+	// Nodes come from a pool owned by the stack and are recycled through a
+	// second lock-free list, never returned to the allocator before the
+	// destructor: a thread that lost a race may still read a popped node.
+	// Nodes are named by 32-bit indices, so the head packs an index and an
+	// ABA tag bumped on every update into one 64-bit word, which a plain
+	// compare-and-swap handles on every 64-bit target.
+	//   ft::concurrent_stack<Task*> tasks;
+	//   tasks.push(t);
+	//   if (tasks.try_pop(t)) ...
+	template < class T, class Alloc = std::allocator<T> >
+	class concurrent_stack
+	{
+	public:
+		typedef T				value_type;
+		typedef Alloc			allocator_type;
+		typedef std::size_t		size_type;
+
+		explicit concurrent_stack(const allocator_type& alloc = allocator_type())
+			: _alloc(alloc), _head(_pack(nil, 0)), _free(_pack(nil, 0)), _used(0)
+		{
+			for (size_type k = 0; k < chunk_count; k++)
+				_chunks[k].store(nullptr, std::memory_order_relaxed);
+		}
+
+		concurrent_stack(const concurrent_stack&) = delete;
+		concurrent_stack &operator=(const concurrent_stack&) = delete;
+
+		// Not thread-safe: no other thread may use the stack anymore
+		~concurrent_stack()
+		{
+			uint32_t	idx;
+
+			while ((idx = this->_pop_node(_head)) != nil)
+				this->_value(idx)->~T();
+			for (size_type k = 0; k < chunk_count; k++)
+			{
+				node* chunk = _chunks[k].load(std::memory_order_relaxed);
+				if (chunk)
+					_alloc.deallocate(chunk, _chunk_size(k));
+			}
+		}
+
+		void push(const value_type& val)
+		{
+			this->emplace(val);
+		}
+
+		void push(value_type&& val)
+		{
+			this->emplace(std::move(val));
+		}
+
+		template <class... Args>
+		void emplace(Args&&... args)
+		{
+			uint32_t	idx = this->_get_node();
+
+			try
+			{
+				::new (static_cast<void*>(this->_value(idx))) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				this->_push_node(_free, idx);
+				throw;
+			}
+			this->_push_node(_head, idx);
+		}
+
+		// Moves the top element into out; false when the stack was empty.
+		// If that move throws, the element is pushed back before rethrowing.
+		bool try_pop(value_type& out)
+		{
+			uint32_t	idx = this->_pop_node(_head);
+
+			if (idx == nil)
+				return false;
+			T*	val = this->_value(idx);
+			try
+			{
+				out = std::move(*val);
+			}
+			catch (...)
+			{
+				this->_push_node(_head, idx);
+				throw;
+			}
+			val->~T();
+			this->_push_node(_free, idx);
+			return true;
+		}
+
+		// Only a snapshot: other threads may change it right after
+		bool empty() const
+		{
+			return _index(_head.load(std::memory_order_acquire)) == nil;
+		}
+
+		bool is_lock_free() const
+		{
+			return _head.is_lock_free();
+		}
+
+		allocator_type get_allocator() const
+		{
+			return allocator_type(_alloc);
+		}
+
+	private:
+		struct node
+		{
+			std::atomic<uint32_t>	next;
+			alignas(T) unsigned char	storage[sizeof(T)];
+		};
+
+		typedef typename allocator_type::template rebind<node>::other	node_allocator_type;
+
+		static const uint32_t	nil = 0xFFFFFFFFu;
+		// Chunk k holds first_chunk << k nodes: 26 chunks cover almost every 32-bit index
+		static const size_type	first_chunk = 64;
+		static const size_type	chunk_count = 26;
+		static const uint64_t	max_nodes = static_cast<uint64_t>(first_chunk) * ((1ull << chunk_count) - 1);
+
+		node_allocator_type		_alloc;
+		// Each hot word on its own cache line
+		alignas(64) std::atomic<uint64_t>	_head;
+		alignas(64) std::atomic<uint64_t>	_free;
+		alignas(64) std::atomic<uint64_t>	_used;	// nodes ever handed out by the pool
+		std::atomic<node*>					_chunks[chunk_count];
+
+		static uint64_t	_pack(uint32_t idx, uint32_t tag)
+		{
+			return (static_cast<uint64_t>(tag) << 32) | idx;
+		}
+
+		static uint32_t	_index(uint64_t word)
+		{
+			return static_cast<uint32_t>(word);
+		}
+
+		static uint32_t	_tag(uint64_t word)
+		{
+			return static_cast<uint32_t>(word >> 32);
+		}
+
+		static size_type	_chunk_size(size_type k)
+		{
+			return first_chunk << k;
+		}
+
+		// Index i lives in chunk k where first_chunk << k <= i + first_chunk < first_chunk << (k + 1)
+		static size_type	_chunk_of(uint64_t pos)
+		{
+#ifdef __GNUC__
+			// 6 == log2(first_chunk)
+			return 63 - __builtin_clzll(pos) - 6;
+#else
+			size_type	k = 0;
+			while ((static_cast<uint64_t>(first_chunk) << (k + 1)) <= pos)
+				k++;
+			return k;
+#endif
+		}
+
+		node*	_node(uint32_t idx) const
+		{
+			uint64_t	pos = static_cast<uint64_t>(idx) + first_chunk;
+			size_type	k = _chunk_of(pos);
+
+			return _chunks[k].load(std::memory_order_acquire) + (pos - _chunk_size(k));
+		}
+
+		T*	_value(uint32_t idx) const
+		{
+			return reinterpret_cast<T*>(this->_node(idx)->storage);
+		}
+
+		void	_push_node(std::atomic<uint64_t>& list, uint32_t idx)
+		{
+			node*		n = this->_node(idx);
+			uint64_t	old = list.load(std::memory_order_relaxed);
+
+			do
+				n->next.store(_index(old), std::memory_order_relaxed);
+			while (!list.compare_exchange_weak(old, _pack(idx, _tag(old) + 1),
+						std::memory_order_release, std::memory_order_relaxed));
+		}
+
+		// The tag makes the exchange fail if the top was popped and pushed
+		// back in between, even though its index is the same again
+		uint32_t	_pop_node(std::atomic<uint64_t>& list)
+		{
+			uint64_t	old = list.load(std::memory_order_acquire);
+
+			while (_index(old) != nil)
+			{
+				uint32_t next = this->_node(_index(old))->next.load(std::memory_order_relaxed);
+				if (list.compare_exchange_weak(old, _pack(next, _tag(old) + 1),
+						std::memory_order_acquire, std::memory_order_acquire))
+					return _index(old);
+			}
+			return nil;
+		}
+
+		// A recycled node, or the next never used one, allocating its chunk
+		// if this thread is the first to reach it
+		uint32_t	_get_node()
+		{
+			uint32_t	idx = this->_pop_node(_free);
+
+			if (idx != nil)
+				return idx;
+			uint64_t	n = _used.fetch_add(1, std::memory_order_relaxed);
+			if (n >= max_nodes)
+				throw std::bad_alloc();
+			size_type	k = _chunk_of(n + first_chunk);
+			if (!_chunks[k].load(std::memory_order_acquire))
+			{
+				node*	chunk = _alloc.allocate(_chunk_size(k));
+				node*	expected = nullptr;
+				for (size_type i = 0; i < _chunk_size(k); i++)
+					::new (static_cast<void*>(&chunk[i].next)) std::atomic<uint32_t>(nil);
+				if (!_chunks[k].compare_exchange_strong(expected, chunk,
+						std::memory_order_acq_rel, std::memory_order_acquire))
+					_alloc.deallocate(chunk, _chunk_size(k));
+			}
+			return static_cast<uint32_t>(n);
+		}
+	};
+}
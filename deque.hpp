@@ -0,0 +1,412 @@
+#pragma once
+
+# include <memory>
+# include <algorithm>
+# include <cstddef>
+# include <stdexcept>
+# include <utility>
+# include "./utils/utils.hpp"
+# include "./utils/deque_iterator.hpp"
+
+namespace ft
+{
+	// Largest power of two not above n, and at least b
+	constexpr std::size_t deque_block_size(std::size_t n, std::size_t b = 16)
+	{
+		return b * 2 <= n ? deque_block_size(n, b * 2) : b;
+	}
+
+	// Double-ended queue over fixed-size blocks reached through a block map.
+	// Pushing or popping at either end never moves an element: references stay
+	// valid, only the map of block pointers is reallocated as it fills up.
+	// Usable as the container of ft::stack:
+	//   ft::stack<Buffer, ft::deque<Buffer> >
+	template < class T, class Alloc = std::allocator<T> >
+	class deque
+	{
+	public:
+		// Elements per block: a power of two filling about 4 KiB, 16 at least
+		static const std::size_t	block_size = ft::deque_block_size(4096 / sizeof(T));
+
+		typedef T                                           				value_type;
+		typedef Alloc                                       				allocator_type;
+		typedef typename allocator_type::reference          				reference;
+		typedef typename allocator_type::const_reference    				const_reference;
+		typedef typename allocator_type::pointer            				pointer;
+		typedef typename allocator_type::const_pointer      				const_pointer;
+		typedef ft::deque_iterator<value_type, block_size>             		iterator;
+		typedef ft::deque_iterator<const value_type, block_size>       		const_iterator;
+		typedef ft::reverse_iterator<iterator>             					reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>       					const_reverse_iterator;
+		typedef ptrdiff_t													difference_type;
+		typedef typename allocator_type::size_type          				size_type;
+
+		explicit deque(const allocator_type& alloc = allocator_type())
+			: _alloc(alloc), _map(nullptr), _map_size(0), _start(0), _size(0)
+		{}
+
+		explicit deque(size_type n, const value_type& val = value_type(),
+				const allocator_type& alloc = allocator_type())
+			: _alloc(alloc), _map(nullptr), _map_size(0), _start(0), _size(0)
+		{
+			try
+			{
+				this->resize(n, val);
+			}
+			catch (...)
+			{
+				this->_release();
+				throw;
+			}
+		}
+
+		template <class InputIterator>
+				deque (InputIterator first, InputIterator last,
+						const allocator_type& alloc = allocator_type(),
+						typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = nullptr)
+			: _alloc(alloc), _map(nullptr), _map_size(0), _start(0), _size(0)
+		{
+			try
+			{
+				for (; first != last; first++)
+					this->push_back(*first);
+			}
+			catch (...)
+			{
+				this->_release();
+				throw;
+			}
+		}
+
+		deque (const deque& x)
+			: _alloc(x._alloc), _map(nullptr), _map_size(0), _start(0), _size(0)
+		{
+			try
+			{
+				for (size_type i = 0; i < x._size; i++)
+					this->push_back(x[i]);
+			}
+			catch (...)
+			{
+				this->_release();
+				throw;
+			}
+		}
+
+		deque (deque&& x) noexcept
+			: _alloc(x._alloc), _map(x._map), _map_size(x._map_size), _start(x._start), _size(x._size)
+		{
+			x._map = nullptr;
+			x._map_size = 0;
+			x._start = 0;
+			x._size = 0;
+		}
+
+		deque &operator=(const deque& x)
+		{
+			if (this != &x)
+			{
+				deque tmp(x);
+				this->swap(tmp);
+			}
+			return *this;
+		}
+
+		deque &operator=(deque&& x) noexcept
+		{
+			if (this != &x)
+			{
+				deque tmp(std::move(x));
+				this->swap(tmp);
+			}
+			return *this;
+		}
+
+		~deque()
+		{
+			this->_release();
+		}
+
+		iterator begin() { return iterator(_map, _start); }
+
+		const_iterator begin() const { return const_iterator(_map, _start); }
+
+		iterator end() { return iterator(_map, _start + _size); }
+
+		const_iterator end() const { return const_iterator(_map, _start + _size); }
+
+		reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+
+		reverse_iterator rend() { return reverse_iterator(this->begin()); }
+
+		const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+		size_type   size(void) const { return _size; }
+
+		size_type   max_size(void) const { return _alloc.max_size(); }
+
+		bool        empty(void) const { return !_size; }
+
+		void        resize(size_type n, value_type val = value_type())
+		{
+			while (_size > n)
+				this->pop_back();
+			while (_size < n)
+				this->push_back(val);
+		}
+
+		reference operator[](size_type n) { return *this->_at(_start + n); }
+
+		const_reference operator[](size_type n) const { return *this->_at(_start + n); }
+
+		reference at(size_type n)
+		{
+			if (n >= _size)
+				throw std::out_of_range("index out of range");
+			return (*this)[n];
+		}
+
+		const_reference at(size_type n) const
+		{
+			if (n >= _size)
+				throw std::out_of_range("index out of range");
+			return (*this)[n];
+		}
+
+		reference front() { return (*this)[0]; }
+
+		const_reference front() const { return (*this)[0]; }
+
+		reference back() { return (*this)[_size - 1]; }
+
+		const_reference back() const { return (*this)[_size - 1]; }
+
+		void push_back(const value_type& val) { this->emplace_back(val); }
+
+		void push_back(value_type&& val) { this->emplace_back(std::move(val)); }
+
+		void push_front(const value_type& val) { this->emplace_front(val); }
+
+		void push_front(value_type&& val) { this->emplace_front(std::move(val)); }
+
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			size_type	pos = _start + _size;
+
+			if (pos / block_size >= _map_size)
+			{
+				this->_grow_map(false);
+				pos = _start + _size;
+			}
+			bool fresh = this->_ensure_block(pos / block_size);
+			try
+			{
+				this->_construct(this->_at(pos), std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				if (fresh)
+					this->_free_block(pos / block_size);
+				throw;
+			}
+			_size++;
+		}
+
+		template <class... Args>
+		void emplace_front(Args&&... args)
+		{
+			if (_start == 0)
+				this->_grow_map(true);
+			size_type	pos = _start - 1;
+			bool fresh = this->_ensure_block(pos / block_size);
+			try
+			{
+				this->_construct(this->_at(pos), std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				if (fresh)
+					this->_free_block(pos / block_size);
+				throw;
+			}
+			_start = pos;
+			_size++;
+		}
+
+		void pop_back()
+		{
+			if (!_size)
+				return ;
+			size_type	pos = _start + _size - 1;
+			_alloc.destroy(this->_at(pos));
+			_size--;
+			//le bloc qui vient de se vider reste en reserve, on libere le precedent
+			if (pos % block_size == 0 && pos / block_size + 1 < _map_size)
+				this->_free_block(pos / block_size + 1);
+		}
+
+		void pop_front()
+		{
+			if (!_size)
+				return ;
+			_alloc.destroy(this->_at(_start));
+			_size--;
+			_start++;
+			if (_start % block_size == 0 && _start / block_size >= 2)
+				this->_free_block(_start / block_size - 2);
+		}
+
+		void swap(deque& x)
+		{
+			std::swap(_alloc, x._alloc);
+			std::swap(_map, x._map);
+			std::swap(_map_size, x._map_size);
+			std::swap(_start, x._start);
+			std::swap(_size, x._size);
+		}
+
+		void clear()
+		{
+			while (_size)
+				this->pop_back();
+		}
+
+		allocator_type get_allocator() const
+		{
+			return allocator_type(_alloc);
+		}
+
+	private:
+		typedef typename allocator_type::template rebind<pointer>::other	map_allocator_type;
+
+		allocator_type	_alloc;
+		pointer*		_map;
+		size_type		_map_size;
+		size_type		_start;		// position of the first element, counted from _map[0][0]
+		size_type		_size;
+
+		pointer	_at(size_type pos) const
+		{
+			return _map[pos / block_size] + pos % block_size;
+		}
+
+		template <class... Args>
+		void	_construct(pointer p, Args&&... args)
+		{
+			std::allocator_traits<allocator_type>::construct(_alloc, p, std::forward<Args>(args)...);
+		}
+
+		// Returns true when the block had to be allocated
+		bool	_ensure_block(size_type b)
+		{
+			if (_map[b])
+				return false;
+			_map[b] = _alloc.allocate(block_size);
+			return true;
+		}
+
+		void	_free_block(size_type b)
+		{
+			if (_map[b])
+			{
+				_alloc.deallocate(_map[b], block_size);
+				_map[b] = nullptr;
+			}
+		}
+
+		// Centres the blocks in use in a new map, so both ends get room again,
+		// doubling it unless they fill less than half of it; only block pointers move
+		void	_grow_map(bool front)
+		{
+			map_allocator_type	map_alloc(_alloc);
+			size_type			used_first = _start / block_size;
+			size_type			used = _size ? (_start + _size - 1) / block_size - used_first + 1 : 0;
+			size_type			new_size = _map_size ? _map_size * 2 : 8;
+
+			if (used + 2 <= _map_size / 2)
+				new_size = _map_size;
+			pointer*			new_map = map_alloc.allocate(new_size);
+
+			for (size_type i = 0; i < new_size; i++)
+				new_map[i] = nullptr;
+			size_type	first = (new_size - used) / 2;
+			if (front && first == 0)
+				first = 1;
+			for (size_type i = 0; i < used; i++)
+			{
+				new_map[first + i] = _map[used_first + i];
+				_map[used_first + i] = nullptr;
+			}
+			if (_map)
+			{
+				for (size_type i = 0; i < _map_size; i++)
+					if (_map[i])
+						_alloc.deallocate(_map[i], block_size);
+				map_alloc.deallocate(_map, _map_size);
+			}
+			_start = first * block_size + _start % block_size;
+			_map = new_map;
+			_map_size = new_size;
+		}
+
+		void	_release()
+		{
+			this->clear();
+			if (!_map)
+				return ;
+			map_allocator_type	map_alloc(_alloc);
+			for (size_type i = 0; i < _map_size; i++)
+				if (_map[i])
+					_alloc.deallocate(_map[i], block_size);
+			map_alloc.deallocate(_map, _map_size);
+			_map = nullptr;
+			_map_size = 0;
+			_start = 0;
+		}
+	};
+
+	template <class T, class Alloc>
+	bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+	{
+		return (ft::sequence_equal(lhs, rhs));
+	}
+
+	template <class T, class Alloc>
+	bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class T, class Alloc>
+	bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+	{
+		return (ft::sequence_less(lhs, rhs));
+	}
+
+	template <class T, class Alloc>
+	bool operator<=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class T, class Alloc>
+	bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class T, class Alloc>
+	bool operator>=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class T, class Alloc>
+	void swap(deque<T, Alloc>& x, deque<T, Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
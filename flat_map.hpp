@@ -0,0 +1,387 @@
+#pragma once
+#include <iostream>
+#include <stdexcept>
+#include "utils/utils.hpp"
+#include "utils/flat_map_iterator.hpp"
+#include "vector.hpp"
+
+namespace ft {
+	// Sorted-vector map: keys and values live in two parallel ft::vector,
+	// lookups are binary searches over the contiguous key array.
+	// Insertion and erasure are O(n), meant for read-mostly tables.
+	// Both containers must have contiguous iterators (ft::vector, ft::small_vector).
+	template <	class Key,												// flat_map::key_type
+				class T,												// flat_map::mapped_type
+				class Compare = std::less<Key>,							// flat_map::key_compare
+				class KeyContainer = ft::vector<Key>,					// flat_map::key_container_type
+				class MappedContainer = ft::vector<T> >					// flat_map::mapped_container_type
+	class flat_map {
+		public:
+			typedef	Key													key_type;
+			typedef T													mapped_type;
+			typedef	ft::pair<Key, T>									value_type;
+			typedef	Compare												key_compare;
+			typedef KeyContainer										key_container_type;
+			typedef MappedContainer										mapped_container_type;
+
+			typedef ft::pair<const Key&, T&>							reference;
+			typedef ft::pair<const Key&, const T&>						const_reference;
+
+			typedef flat_map_iterator<Key, T>							iterator;
+			typedef flat_map_iterator<Key, const T>						const_iterator;
+			typedef ft::reverse_iterator<iterator>						reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>				const_reverse_iterator;
+
+			typedef	ptrdiff_t											difference_type;
+			typedef	std::size_t											size_type;
+
+			//les iterateurs sont des pointeurs dans les deux tableaux
+			static_assert(ft::is_contiguous_iterator<typename KeyContainer::iterator>::value,
+				"flat_map: KeyContainer must store its elements contiguously");
+			static_assert(ft::is_contiguous_iterator<typename MappedContainer::iterator>::value,
+				"flat_map: MappedContainer must store its elements contiguously");
+
+			class value_compare {
+				protected:
+					Compare comp;
+				public:
+					typedef bool result_type;
+					typedef value_type first_argument_type;
+					typedef value_type second_argument_type;
+					value_compare(Compare c) : comp(c) {}
+					template <class P1, class P2>
+					bool operator() (const P1& x, const P2& y) const
+					{
+						return comp(x.first, y.first);
+					}
+			};
+
+			explicit flat_map (const key_compare& _comp = key_compare())
+				:	comp(_comp) {}
+
+			template <class InputIterator>
+			flat_map (	InputIterator first, InputIterator last,
+						const key_compare& _comp = key_compare())
+				:	comp(_comp) {
+						insert(first, last);
+					}
+
+			//[first, last) doit etre strictement croissant
+			template <class InputIterator>
+			flat_map (	ft::sorted_unique_t, InputIterator first, InputIterator last,
+						const key_compare& _comp = key_compare())
+				:	comp(_comp) {
+						for (; first != last; first++)
+						{
+							_keys.push_back((*first).first);
+							_values.push_back((*first).second);
+						}
+					}
+
+			flat_map (const flat_map& x)
+				:	_keys(x._keys),
+					_values(x._values),
+					comp(x.comp) {}
+
+			~flat_map() {}
+
+			flat_map& operator=(const flat_map& m) {
+				_keys = m._keys;
+				_values = m._values;
+				comp = m.comp;
+				return *this;
+			}
+
+			iterator begin() { return make_iterator(0); }
+			iterator end() { return make_iterator(size()); }
+
+			const_iterator begin() const { return make_iterator(0); }
+			const_iterator end() const { return make_iterator(size()); }
+
+			reverse_iterator rbegin() { return reverse_iterator(end()); }
+			reverse_iterator rend() { return reverse_iterator(begin()); }
+
+			const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+			const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+			bool empty() const { return size() == 0; }
+			size_type size() const { return _keys.size(); }
+			size_type max_size() const { return _keys.max_size(); }
+
+			mapped_type& operator[] (const key_type& k) {
+				size_type i = lower_bound_index(k);
+				if (i == size() || comp(k, _keys[i]))
+					insert_at(i, k, mapped_type());
+				return _values[i];
+			}
+
+			mapped_type& at(const key_type& k) {
+				size_type i = find_index(k);
+				if (i == size())
+					throw std::out_of_range("flat_map::at");
+				return _values[i];
+			}
+
+			const mapped_type& at(const key_type& k) const {
+				size_type i = find_index(k);
+				if (i == size())
+					throw std::out_of_range("flat_map::at");
+				return _values[i];
+			}
+
+			pair<iterator,bool> insert (const value_type& val) {
+				size_type i = lower_bound_index(val.first);
+				if (i != size() && !comp(val.first, _keys[i]))
+					return ft::make_pair(make_iterator(i), false);
+				insert_at(i, val.first, val.second);
+				return ft::make_pair(make_iterator(i), true);
+			}
+
+			//hint valable : pas de recherche, sinon recherche binaire
+			iterator insert (iterator position, const value_type& val) {
+				size_type i = position - begin();
+				if ((i == 0 || comp(_keys[i - 1], val.first)) && (i == size() || comp(val.first, _keys[i])))
+				{
+					insert_at(i, val.first, val.second);
+					return make_iterator(i);
+				}
+				return insert(val).first;
+			}
+
+			template <class InputIter>
+			void insert(InputIter first, InputIter last) {
+				iterator hint = end();
+				for (InputIter it = first; it != last; it++)
+				{
+					value_type val((*it).first, (*it).second);
+					hint = insert(hint, val);
+					++hint;
+				}
+			}
+
+			// Takes over two already sorted, duplicate-free containers of the same size;
+			// the previous contents end up in keys / values
+			void adopt_sorted(key_container_type& keys, mapped_container_type& values) {
+				_keys.swap(keys);
+				_values.swap(values);
+			}
+
+			const key_container_type& keys() const { return _keys; }
+			const mapped_container_type& values() const { return _values; }
+
+			void erase (iterator position) {
+				size_type i = position - begin();
+				_keys.erase(_keys.begin() + i);
+				_values.erase(_values.begin() + i);
+			}
+			size_type erase (const key_type& k) {
+				size_type i = find_index(k);
+				if (i == size())
+					return 0;
+				erase(make_iterator(i));
+				return 1;
+			}
+			void erase (iterator first, iterator last) {
+				size_type i = first - begin();
+				size_type j = last - begin();
+				_keys.erase(_keys.begin() + i, _keys.begin() + j);
+				_values.erase(_values.begin() + i, _values.begin() + j);
+			}
+
+			void swap (flat_map& x) {
+				_keys.swap(x._keys);
+				_values.swap(x._values);
+				key_compare tmp = comp;
+				comp = x.comp;
+				x.comp = tmp;
+			}
+
+			void clear() {
+				_keys.clear();
+				_values.clear();
+			}
+
+			key_compare		key_comp() const { return comp; }
+			value_compare	value_comp() const { return value_compare(comp); }
+
+			iterator	find (const key_type& k) { return make_iterator(find_index(k)); }
+			const_iterator find (const key_type& k) const { return make_iterator(find_index(k)); }
+
+			size_type count (const key_type& k) const { return find_index(k) != size(); }
+
+			iterator lower_bound (const key_type& k) { return make_iterator(lower_bound_index(k)); }
+			const_iterator lower_bound (const key_type& k) const { return make_iterator(lower_bound_index(k)); }
+
+			iterator upper_bound (const key_type& k) { return make_iterator(upper_bound_index(k)); }
+			const_iterator upper_bound (const key_type& k) const { return make_iterator(upper_bound_index(k)); }
+
+			pair<const_iterator,const_iterator> equal_range (const key_type& k) const {
+				return ft::make_pair<const_iterator, const_iterator> (lower_bound(k), upper_bound(k));
+			}
+			pair<iterator,iterator>             equal_range (const key_type& k) {
+				return ft::make_pair<iterator, iterator> (lower_bound(k), upper_bound(k));
+			}
+
+			// Overloads for any type comparable to key_type, only when
+			// key_compare is transparent (declares is_transparent)
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type find (const K& k) {
+				return make_iterator(find_index(k));
+			}
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type find (const K& k) const {
+				return make_iterator(find_index(k));
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, size_type>::type count (const K& k) const {
+				return find_index(k) != size();
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type lower_bound (const K& k) {
+				return make_iterator(lower_bound_index(k));
+			}
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type lower_bound (const K& k) const {
+				return make_iterator(lower_bound_index(k));
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type upper_bound (const K& k) {
+				return make_iterator(upper_bound_index(k));
+			}
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type upper_bound (const K& k) const {
+				return make_iterator(upper_bound_index(k));
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, pair<iterator,iterator> >::type equal_range (const K& k) {
+				return ft::make_pair<iterator, iterator> (lower_bound(k), upper_bound(k));
+			}
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, pair<const_iterator,const_iterator> >::type equal_range (const K& k) const {
+				return ft::make_pair<const_iterator, const_iterator> (lower_bound(k), upper_bound(k));
+			}
+
+		private:
+			key_container_type		_keys;
+			mapped_container_type	_values;
+			key_compare				comp;
+
+			iterator make_iterator(size_type i) {
+				return iterator(_keys.empty() ? 0 : &_keys[0] + i, _values.empty() ? 0 : &_values[0] + i);
+			}
+
+			const_iterator make_iterator(size_type i) const {
+				return const_iterator(_keys.empty() ? 0 : &_keys[0] + i, _values.empty() ? 0 : &_values[0] + i);
+			}
+
+			template <class K>
+			size_type lower_bound_index(const K& k) const {
+				size_type	lo = 0;
+				size_type	len = size();
+				while (len)
+				{
+					size_type half = len / 2;
+					if (comp(_keys[lo + half], k))
+					{
+						lo += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return lo;
+			}
+
+			template <class K>
+			size_type upper_bound_index(const K& k) const {
+				size_type	lo = 0;
+				size_type	len = size();
+				while (len)
+				{
+					size_type half = len / 2;
+					if (!comp(k, _keys[lo + half]))
+					{
+						lo += half + 1;
+						len -= half + 1;
+					}
+					else
+						len = half;
+				}
+				return lo;
+			}
+
+			template <class K>
+			size_type find_index(const K& k) const {
+				size_type i = lower_bound_index(k);
+				if (i != size() && comp(k, _keys[i]))
+					return size();
+				return i;
+			}
+
+			void insert_at(size_type i, const key_type& k, const mapped_type& v) {
+				_keys.insert(_keys.begin() + i, k);
+				try
+				{
+					_values.insert(_values.begin() + i, v);
+				}
+				catch (...)
+				{
+					_keys.erase(_keys.begin() + i);
+					throw;
+				}
+			}
+	};
+
+	template <class Key, class T, class Compare, class KC, class MC>
+	bool operator== (const flat_map<Key, T, Compare, KC, MC>& lhs, const flat_map<Key, T, Compare, KC, MC>& rhs) {
+		return lhs.keys() == rhs.keys() && lhs.values() == rhs.values();
+	}
+
+	template <class Key, class T, class Compare, class KC, class MC>
+	bool operator!= (const flat_map<Key, T, Compare, KC, MC>& lhs, const flat_map<Key, T, Compare, KC, MC>& rhs) {
+		return !(lhs == rhs);
+	}
+
+	template <class Key, class T, class Compare, class KC, class MC>
+	bool operator< (const flat_map<Key, T, Compare, KC, MC>& lhs, const flat_map<Key, T, Compare, KC, MC>& rhs) {
+		typedef typename flat_map<Key, T, Compare, KC, MC>::const_iterator const_iterator;
+		const_iterator ita = lhs.begin();
+		const_iterator itae = lhs.end();
+		const_iterator itb = rhs.begin();
+		const_iterator itbe = rhs.end();
+		while (ita != itae && itb != itbe)
+		{
+			if (ita->first < itb->first || (!(itb->first < ita->first) && ita->second < itb->second))
+				return true;
+			if (itb->first < ita->first || (!(ita->first < itb->first) && itb->second < ita->second))
+				return false;
+			ita++;
+			itb++;
+		}
+		return (ita == itae && itb != itbe);
+	}
+
+	template <class Key, class T, class Compare, class KC, class MC>
+	bool operator<= (const flat_map<Key, T, Compare, KC, MC>& lhs, const flat_map<Key, T, Compare, KC, MC>& rhs) {
+		return !(rhs < lhs);
+	}
+
+	template <class Key, class T, class Compare, class KC, class MC>
+	bool operator> (const flat_map<Key, T, Compare, KC, MC>& lhs, const flat_map<Key, T, Compare, KC, MC>& rhs) {
+		return rhs < lhs;
+	}
+
+	template <class Key, class T, class Compare, class KC, class MC>
+	bool operator>= (const flat_map<Key, T, Compare, KC, MC>& lhs, const flat_map<Key, T, Compare, KC, MC>& rhs) {
+		return !(lhs < rhs);
+	}
+
+	template <class Key, class T, class Compare, class KC, class MC>
+	void swap (flat_map<Key, T, Compare, KC, MC>& x, flat_map<Key, T, Compare, KC, MC>& y) {
+		x.swap(y);
+	}
+}
@@ -9,6 +9,7 @@
 #include "map.hpp"
 #include "stack.hpp"
 #include "vector.hpp"
+#include "deque.hpp"
 
 #include <stdlib.h>
 
@@ -57,7 +58,7 @@ int main(int argc, char** argv) {
 	ft::vector<int> vector_int;
 	ft::stack<int> stack_int;
 	ft::vector<Buffer> vector_buffer;
-	ft::stack<Buffer, std::deque<Buffer> > stack_deq_buffer;
+	ft::stack<Buffer, ft::deque<Buffer> > stack_deq_buffer;
 	ft::map<int, int> map_int;
 
 	for (int i = 0; i < COUNT; i++)
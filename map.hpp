@@ -2,12 +2,22 @@
 #include <iostream>
 #include "utils/utils.hpp"
 #include "RBbst.hpp"
+#include "BPtree.hpp"
+#include "vector.hpp"
+#include "utils/parallel.hpp"
 
 namespace ft {
+	// Tree selects the storage engine. ft::rb_tree_policy (the default) keeps
+	// the std::map guarantees: iterators and references stay valid across
+	// insertions, and erase only invalidates the erased elements.
+	// ft::bplus_tree_policy<> stores the elements inside B+ tree leaves for
+	// faster lookups and scans, and moves them on every change: any insert or
+	// erase invalidates all iterators, pointers and references into the map.
 	template <	class Key,												// map::key_type
 				class T,												// map::mapped_type
 				class Compare = std::less<Key>,							// map::key_compare
-				class Alloc = std::allocator<ft::pair<const Key, T> > >	// map::allocator_type
+				class Alloc = std::allocator<ft::pair<const Key, T> >,	// map::allocator_type
+				class Tree = ft::rb_tree_policy >						// storage engine
 	class map {
 		public:
 			typedef	Key													key_type;
@@ -21,14 +31,6 @@ namespace ft {
 			typedef	typename allocator_type::pointer					pointer;
 			typedef	typename allocator_type::const_pointer				const_pointer;
 
-			typedef tree_iterator<value_type>							iterator;
-			typedef tree_const_iterator<value_type>						const_iterator;
-			typedef ft::reverse_iterator<iterator>						reverse_iterator;
-			typedef ft::reverse_iterator<const_iterator>				const_reverse_iterator;
-
-			typedef	ptrdiff_t											difference_type;
-			typedef	std::size_t											size_type;
-
 			class value_compare : std::binary_function<value_type, value_type, bool> {
 				// in C++98, it is required to inherit binary_function<value_type,value_type,bool>
 				protected:
@@ -44,9 +46,20 @@ namespace ft {
 					}
 			};
 
+		private:
+			typedef typename Tree::template apply<key_type, value_type, key_compare, value_compare, allocator_type>::type	tree_type;
+		public:
+			typedef typename tree_type::iterator						iterator;
+			typedef typename tree_type::const_iterator					const_iterator;
+			typedef ft::reverse_iterator<iterator>						reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>				const_reverse_iterator;
+
+			typedef	ptrdiff_t											difference_type;
+			typedef	std::size_t											size_type;
+
 			explicit map (	const key_compare& _comp = key_compare(),
               				const allocator_type& _alloc = allocator_type())
-				:	bst(value_compare(_comp)),
+				:	bst(_comp),
 					comp(_comp),
 					alloc(_alloc) {}
 
@@ -54,11 +67,22 @@ namespace ft {
 			map (	InputIterator first, InputIterator last,
 					const key_compare& _comp = key_compare(),
 					const allocator_type& _alloc = allocator_type())
-				:	bst(value_compare(_comp)),
+				:	bst(_comp),
 					comp(_comp),
 					alloc(_alloc) {
 						insert(first, last);
 					}
+
+			//[first, last) doit etre strictement croissant : construction en O(n)
+			template <class InputIterator>
+			map (	ft::sorted_unique_t, InputIterator first, InputIterator last,
+					const key_compare& _comp = key_compare(),
+					const allocator_type& _alloc = allocator_type())
+				:	bst(_comp),
+					comp(_comp),
+					alloc(_alloc) {
+						bst.build_sorted(first, last);
+					}
 			
 			map (const map& x)
 				:	bst(x.bst),
@@ -89,7 +113,10 @@ namespace ft {
 			size_type max_size() const { return bst.max_size(); }
 
 			mapped_type& operator[] (const key_type& k) {
-				return (*((this->insert(ft::make_pair(k,mapped_type()))).first)).second;
+				iterator it = lower_bound(k);
+				if (it == end() || comp(k, it->first))
+					it = bst.insert(it, value_type(k, mapped_type()));
+				return it->second;
 			}
 
 			pair<iterator,bool> insert (const value_type& val) {
@@ -97,33 +124,80 @@ namespace ft {
 			}
 
 			iterator insert (iterator position, const value_type& val) {
-				(void)position;
-				return bst.insert(val).first;
+				return bst.insert(position, val);
 			}
 
+			//une entree a passage unique n'est parcourue qu'une fois : pas de verification prealable de l'ordre
 			template <class InputIter>
 			void insert(InputIter first, InputIter last) {
-				for (InputIter it = first; it != last; it++)
-					bst.insert(*it);
+				insert_range(first, last, std::integral_constant<bool, ft::is_multipass_iterator<InputIter>::value>());
 			}
 
-			void erase (iterator position) { bst.erase(position.as_node()); }
-			size_type erase (const key_type& k) {
-				return bst.erase(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
-			}
-     		void erase (iterator first, iterator last) {
-				iterator cur = first;
-				iterator it = first;
-				while (it != last)
+			// Same result as insert(first, last), sorting the input on `threads`
+			// threads (0: one per core) instead of inserting it element by element:
+			// the first occurrence of a key wins, as do keys already in the map.
+			// An empty map is then built bottom-up in O(n).
+			template <class InputIter>
+			void build_parallel(InputIter first, InputIter last, unsigned threads = 0) {
+				ft::vector<value_type>			staged(first, last);
+				ft::vector<const value_type*>	order(staged.size());
+
+				if (staged.empty())
+					return ;
+				for (size_type i = 0; i < staged.size(); i++)
+					order[i] = &staged[i];
+				const value_type**	data = &order[0];
+				pointee_iterator	b(data);
+				pointee_iterator	e(ft::parallel_sort_unique(data, data + order.size(), pointee_compare(comp), threads));
+				if (empty())
 				{
-					it++;
-					bst.erase(cur.as_node());
-					cur = it;
+					bst.build_sorted(b, e);
+					return ;
 				}
+				iterator hint = this->end();
+				for (; b != e; ++b)
+					hint = bst.insert(hint, *b);
+			}
+
+			void erase (iterator position) { bst.erase(position); }
+			size_type erase (const key_type& k) {
+				return bst.erase(k, key_value_compare(comp));
 			}
+     		void erase (iterator first, iterator last) { bst.erase(first, last); }
 
 			void swap (map& x) { bst.swap(x.bst); }
 
+			// Bulk operations that move whole subtrees between maps instead of
+			// elements, in O(m log(n/m + 1)) for m elements against n with the
+			// red-black tree (the B+ tree rebuilds in O(n + m)).
+			// Both maps must use the same key ordering.
+
+			// Appends x, whose keys must all be greater than this map's; x ends up empty
+			void join (map& x) { bst.join(x.bst); }
+
+			// Moves every element whose key is not less than k into upper,
+			// replacing its previous content
+			void split (const key_type& k, map& upper) {
+				bst.split(k, key_value_compare(comp), upper.bst);
+			}
+
+			// Removes and returns the elements with keys in [lo, hi)
+			map extract_range (const key_type& lo, const key_type& hi) {
+				map ret(comp, alloc);
+				bst.extract_range(lo, hi, key_value_compare(comp), ret.bst);
+				return ret;
+			}
+
+			// Union: takes the elements of x whose key is not in this map, x keeps
+			// the others (like C++17 std::map::merge)
+			void merge (map& x) { bst.merge(x.bst); }
+
+			// Intersection: keeps only the keys also present in x
+			void intersect (const map& x) { bst.intersect(x.bst); }
+
+			// Difference: removes the keys present in x
+			void subtract (const map& x) { bst.subtract(x.bst); }
+
 			void clear() { 
 				bst.clear();
 			}
@@ -132,11 +206,11 @@ namespace ft {
 			value_compare	value_comp() const { return value_compare(comp); }
 
 			iterator	find (const key_type& k) {
-				return bst.find(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
+				return bst.find(k, key_value_compare(comp));
 			}
 			
 			const_iterator find (const key_type& k) const {
-				return bst.find(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
+				return bst.find(k, key_value_compare(comp));
 			}
 
 			size_type count (const key_type& k) const {
@@ -144,43 +218,194 @@ namespace ft {
 			}
 
 			iterator lower_bound (const key_type& k) {
-				return bst.lower_bound(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
+				return bst.lower_bound(k, key_value_compare(comp));
 			}
 			const_iterator lower_bound (const key_type& k) const {
-				return bst.lower_bound(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
+				return bst.lower_bound(k, key_value_compare(comp));
 			}
 
 			iterator upper_bound (const key_type& k) {
-				return bst.upper_bound(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
+				return bst.upper_bound(k, key_value_compare(comp));
 			}
 			const_iterator upper_bound (const key_type& k) const {
-				return bst.upper_bound(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
+				return bst.upper_bound(k, key_value_compare(comp));
+			}
+
+			// Looks up every key of [first, last), writing one iterator per key to
+			// out (end() when absent). The descents of several keys are interleaved
+			// and prefetched so that their cache misses overlap.
+			template <class ForwardIterator, class OutputIterator>
+			OutputIterator find_batch (ForwardIterator first, ForwardIterator last, OutputIterator out) {
+				return bst.find_batch(first, last, out, key_value_compare(comp));
+			}
+			template <class ForwardIterator, class OutputIterator>
+			OutputIterator find_batch (ForwardIterator first, ForwardIterator last, OutputIterator out) const {
+				return bst.find_batch(first, last, out, key_value_compare(comp));
+			}
+
+			// Calls f on every element in key order and returns f. Cheaper than
+			// iterating: the tree is walked with an explicit stack (or along the
+			// leaves) with upcoming nodes prefetched, and f can be inlined.
+			// f may change mapped values but must not insert or erase.
+			template <class F>
+			F for_each (F f) { bst.for_each(f); return f; }
+			template <class F>
+			F for_each (F f) const { bst.for_each(f); return f; }
+
+			// Same, for the elements with keys in [lo, hi)
+			template <class F>
+			F for_each_range (const key_type& lo, const key_type& hi, F f) {
+				bst.for_each_range(lo, hi, key_value_compare(comp), f);
+				return f;
+			}
+			template <class F>
+			F for_each_range (const key_type& lo, const key_type& hi, F f) const {
+				bst.for_each_range(lo, hi, key_value_compare(comp), f);
+				return f;
+			}
+
+			// Order statistics: O(log n) with the red-black tree, which keeps
+			// subtree sizes; the B+ tree skips whole leaves instead
+			iterator nth (size_type n) { return bst.nth(n); }
+			const_iterator nth (size_type n) const { return bst.nth(n); }
+
+			// Number of keys strictly less than k
+			size_type rank (const key_type& k) const {
+				return bst.rank(k, key_value_compare(comp));
+			}
+
+			// Same as ft::distance(first, last), without walking the range
+			difference_type distance (const_iterator first, const_iterator last) const {
+				return static_cast<difference_type>(bst.index_of(last)) - static_cast<difference_type>(bst.index_of(first));
 			}
 
 			pair<const_iterator,const_iterator> equal_range (const key_type& k) const {
-				const_iterator it1 = bst.lower_bound(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
-				const_iterator it2 = bst.upper_bound(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
-				return ft::make_pair<const_iterator, const_iterator> (it1, it2);
+				return ft::make_pair<const_iterator, const_iterator> (lower_bound(k), upper_bound(k));
 			}
 			pair<iterator,iterator>             equal_range (const key_type& k) {
-				iterator it1 = bst.lower_bound(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
-				iterator it2 = bst.upper_bound(ft::make_pair<const key_type, mapped_type> (k, mapped_type()));
-				return ft::make_pair<iterator, iterator> (it1, it2);
+				return ft::make_pair<iterator, iterator> (lower_bound(k), upper_bound(k));
+			}
+
+			// Overloads for any type comparable to key_type, only when
+			// key_compare is transparent (declares is_transparent)
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type find (const K& k) {
+				return bst.find(k, key_value_compare(comp));
+			}
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type find (const K& k) const {
+				return bst.find(k, key_value_compare(comp));
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, size_type>::type count (const K& k) const {
+				return (find(k) != end());
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type lower_bound (const K& k) {
+				return bst.lower_bound(k, key_value_compare(comp));
+			}
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type lower_bound (const K& k) const {
+				return bst.lower_bound(k, key_value_compare(comp));
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, iterator>::type upper_bound (const K& k) {
+				return bst.upper_bound(k, key_value_compare(comp));
+			}
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, const_iterator>::type upper_bound (const K& k) const {
+				return bst.upper_bound(k, key_value_compare(comp));
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, pair<iterator,iterator> >::type equal_range (const K& k) {
+				return ft::make_pair<iterator, iterator> (lower_bound(k), upper_bound(k));
+			}
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, pair<const_iterator,const_iterator> >::type equal_range (const K& k) const {
+				return ft::make_pair<const_iterator, const_iterator> (lower_bound(k), upper_bound(k));
+			}
+
+			template <class K>
+			typename ft::enable_if_transparent<Compare, K, size_type>::type rank (const K& k) const {
+				return bst.rank(k, key_value_compare(comp));
 			}
 
 			allocator_type get_allocator() const {
 				return alloc;
 			}
 		private:
-			RBbst<value_type, value_compare, allocator_type>	bst;
-			key_compare											comp;
-			allocator_type										alloc;
+			template <class ForwardIter>
+			void insert_range(ForwardIter first, ForwardIter last, std::true_type) {
+				if (empty() && bst.is_sorted_unique(first, last))
+				{
+					bst.build_sorted(first, last);
+					return ;
+				}
+				insert_range(first, last, std::false_type());
+			}
+
+			//chaque insertion sert d'indice a la suivante : O(1) amorti sur une entree presque triee
+			template <class InputIter>
+			void insert_range(InputIter first, InputIter last, std::false_type) {
+				iterator hint = end();
+				for (; first != last; ++first)
+					hint = bst.insert(hint, *first);
+			}
+
+			// Compares a bare key against a stored pair, so lookups never build a value_type
+			class key_value_compare {
+				Compare comp;
+				public:
+					key_value_compare(Compare c) : comp(c) {}
+					template <class K>
+					bool operator() (const value_type& x, const K& k) const { return comp(x.first, k); }
+					template <class K>
+					bool operator() (const K& k, const value_type& y) const { return comp(k, y.first); }
+			};
+
+			// Orders pointers to values by key, for build_parallel
+			class pointee_compare {
+				Compare comp;
+				public:
+					pointee_compare(Compare c) : comp(c) {}
+					bool operator() (const value_type* x, const value_type* y) const { return comp(x->first, y->first); }
+			};
+
+			// Walks an array of pointers to values as if it held the values
+			class pointee_iterator {
+				public:
+					typedef std::forward_iterator_tag		iterator_category;
+					typedef typename map::value_type		value_type;
+					typedef const value_type&				reference;
+					typedef const value_type*				pointer;
+					typedef ptrdiff_t						difference_type;
+
+				private:
+					const value_type* const*	p;
+
+				public:
+					pointee_iterator(const value_type* const* _p) : p(_p) {}
+					reference operator*() const { return **p; }
+					pointer operator->() const { return *p; }
+					pointee_iterator& operator++() { ++p; return *this; }
+					pointee_iterator operator++(int) { pointee_iterator ret(*this); ++p; return ret; }
+					bool operator==(const pointee_iterator& x) const { return p == x.p; }
+					bool operator!=(const pointee_iterator& x) const { return p != x.p; }
+			};
+
+			tree_type			bst;
+			key_compare			comp;
+			allocator_type		alloc;
 
 	};
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator== (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
-		typedef typename map<Key, T, Compare, Alloc>::const_iterator const_iterator;
+	template <class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator== (const map<Key, T, Compare, Alloc, Tree>& lhs, const map<Key, T, Compare, Alloc, Tree>& rhs) {
+		typedef typename map<Key, T, Compare, Alloc, Tree>::const_iterator const_iterator;
 		if (lhs.size() != rhs.size())
 			return false;
 		const_iterator itab = lhs.begin();
@@ -198,15 +423,15 @@ namespace ft {
 		return true;
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator!= (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
+	template <class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator!= (const map<Key, T, Compare, Alloc, Tree>& lhs, const map<Key, T, Compare, Alloc, Tree>& rhs) {
 		return !(lhs == rhs);
 	}
 
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator< (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
-		typedef typename map<Key, T, Compare, Alloc>::const_iterator const_iterator;
+	template <class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator< (const map<Key, T, Compare, Alloc, Tree>& lhs, const map<Key, T, Compare, Alloc, Tree>& rhs) {
+		typedef typename map<Key, T, Compare, Alloc, Tree>::const_iterator const_iterator;
 		const_iterator itab = lhs.begin();
 		const_iterator itae = lhs.end();
 		const_iterator itbb = rhs.begin();
@@ -227,9 +452,9 @@ namespace ft {
 		return true;
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator<= (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
-		typedef typename map<Key, T, Compare, Alloc>::const_iterator const_iterator;
+	template <class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator<= (const map<Key, T, Compare, Alloc, Tree>& lhs, const map<Key, T, Compare, Alloc, Tree>& rhs) {
+		typedef typename map<Key, T, Compare, Alloc, Tree>::const_iterator const_iterator;
 		const_iterator itab = lhs.begin();
 		const_iterator itae = lhs.end();
 		const_iterator itbb = rhs.begin();
@@ -250,9 +475,9 @@ namespace ft {
 		return true;
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator> (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
-		typedef typename map<Key, T, Compare, Alloc>::const_iterator const_iterator;
+	template <class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator> (const map<Key, T, Compare, Alloc, Tree>& lhs, const map<Key, T, Compare, Alloc, Tree>& rhs) {
+		typedef typename map<Key, T, Compare, Alloc, Tree>::const_iterator const_iterator;
 		const_iterator itab = lhs.begin();
 		const_iterator itae = lhs.end();
 		const_iterator itbb = rhs.begin();
@@ -273,9 +498,9 @@ namespace ft {
 		return true;
 	}
 
-	template <class Key, class T, class Compare, class Alloc>
-	bool operator>= (const map<Key, T, Compare, Alloc>& lhs, const map<Key, T, Compare, Alloc>& rhs) {
-		typedef typename map<Key, T, Compare, Alloc>::const_iterator const_iterator;
+	template <class Key, class T, class Compare, class Alloc, class Tree>
+	bool operator>= (const map<Key, T, Compare, Alloc, Tree>& lhs, const map<Key, T, Compare, Alloc, Tree>& rhs) {
+		typedef typename map<Key, T, Compare, Alloc, Tree>::const_iterator const_iterator;
 		const_iterator itab = lhs.begin();
 		const_iterator itae = lhs.end();
 		const_iterator itbb = rhs.begin();
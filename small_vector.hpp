@@ -0,0 +1,466 @@
+#pragma once
+
+# include "vector.hpp"
+
+namespace ft
+{
+	// Vector that keeps up to N elements in an inline buffer and only goes to
+	// the allocator once it outgrows it. While inline, moving or swapping it
+	// moves the elements one by one. Usable as the container of ft::stack:
+	//   ft::stack<int, ft::small_vector<int, 16> >
+	template < class T, std::size_t N, class Alloc = std::allocator<T> >
+	class small_vector
+	{
+		static_assert(N > 0, "small_vector needs an inline capacity");
+
+	public:
+
+		typedef T                                           				value_type;
+		typedef Alloc                                       				allocator_type;
+		typedef typename allocator_type::reference          				reference;
+		typedef typename allocator_type::const_reference    				const_reference;
+		typedef typename allocator_type::pointer            				pointer;
+		typedef typename allocator_type::const_pointer      				const_pointer;
+		typedef ft::random_access_iterator<value_type>               		iterator;
+		typedef ft::random_access_iterator<const value_type>            	const_iterator;
+		typedef ft::reverse_iterator<iterator>             					reverse_iterator;
+		typedef ft::reverse_iterator<const_iterator>       					const_reverse_iterator;
+		typedef typename ft::iterator_traits<iterator>::difference_type		difference_type;
+		typedef typename allocator_type::size_type          				size_type;
+
+		static const size_type	inline_capacity = N;
+
+		explicit small_vector(const allocator_type& alloc = allocator_type()) : _alloc(alloc), _start(_inline()), _size(0), _capacity(N)
+		{}
+
+		explicit small_vector(size_type n, const value_type& val = value_type(),
+				const allocator_type& alloc = allocator_type()) : _alloc(alloc), _start(_inline()), _size(0), _capacity(N)
+		{
+			try
+			{
+				this->assign(n, val);
+			}
+			catch (...)
+			{
+				this->_release();
+				throw;
+			}
+		}
+
+		template <class InputIterator>
+				small_vector (InputIterator first, InputIterator last,
+						const allocator_type& alloc = allocator_type(),
+						typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = nullptr)
+				: _alloc(alloc), _start(_inline()), _size(0), _capacity(N)
+		{
+			try
+			{
+				this->assign(first, last);
+			}
+			catch (...)
+			{
+				this->_release();
+				throw;
+			}
+		}
+
+		small_vector (const small_vector& x) : _alloc(x._alloc), _start(_inline()), _size(0), _capacity(N)
+		{
+			try
+			{
+				this->assign(x.begin(), x.end());
+			}
+			catch (...)
+			{
+				this->_release();
+				throw;
+			}
+		}
+
+		small_vector (small_vector&& x) noexcept(std::is_nothrow_move_constructible<T>::value)
+				: _alloc(x._alloc), _start(_inline()), _size(0), _capacity(N)
+		{
+			this->_steal(x);
+		}
+
+		small_vector &operator=(const small_vector& x)
+		{
+			if (this != &x)
+				this->assign(x.begin(), x.end());
+			return *this;
+		}
+
+		small_vector &operator=(small_vector&& x)
+		{
+			if (this != &x)
+			{
+				this->clear();
+				if (x._is_heap())
+				{
+					// the buffer taken from x is freed by our allocator later
+					this->_release();
+					_alloc = x._alloc;
+				}
+				this->_steal(x);
+			}
+			return *this;
+		}
+
+		~small_vector()
+		{
+			this->clear();
+			this->_release();
+		}
+
+		iterator begin() { return _start; }
+
+		const_iterator begin() const { return _start; }
+
+		iterator end() { return _start + _size; }
+
+		const_iterator end() const { return _start + _size; }
+
+		reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+
+		const_reverse_iterator rbegin() const { return const_reverse_iterator(this->end()); }
+
+		reverse_iterator rend() { return reverse_iterator(this->begin()); }
+
+		const_reverse_iterator rend() const { return const_reverse_iterator(this->begin()); }
+
+		size_type   size(void) const { return _size; }
+
+		size_type   max_size(void) const { return _alloc.max_size(); }
+
+		size_type   capacity(void) const { return _capacity; }
+
+		bool        empty(void) const { return !_size; }
+
+		// True while the elements live in the inline buffer
+		bool        is_inline(void) const { return !this->_is_heap(); }
+
+		void        reserve(size_type n)
+		{
+			if (n > this->max_size())
+				throw std::length_error("small_vector::reserve");
+			if (n > _capacity)
+				this->_reallocate(n);
+		}
+
+		void        resize(size_type n, value_type val = value_type())
+		{
+			if (n > _size)
+			{
+				this->_grow(n);
+				while (_size < n)
+					this->_construct(_start + _size++, val);
+			}
+			else
+				this->_destroy_tail(n);
+		}
+
+		reference operator[](size_type n) { return _start[n]; }
+
+		const_reference operator[](size_type n) const { return _start[n]; }
+
+		reference at(size_type n)
+		{
+			if (n >= _size)
+				throw std::out_of_range("index out of range");
+			return _start[n];
+		}
+
+		const_reference at(size_type n) const
+		{
+			if (n >= _size)
+				throw std::out_of_range("index out of range");
+			return _start[n];
+		}
+
+		reference front() { return *_start; }
+
+		const_reference front() const { return *_start; }
+
+		reference back() { return _start[_size - 1]; }
+
+		const_reference back() const { return _start[_size - 1]; }
+
+		template <class InputIterator>
+		void assign(InputIterator first, InputIterator last,
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = nullptr)
+		{
+			this->clear();
+			for (; first != last; first++)
+				this->emplace_back(*first);
+		}
+
+		void assign(size_type n, const value_type& val)
+		{
+			// val may be an element
+			value_type	tmp(val);
+
+			this->clear();
+			this->resize(n, tmp);
+		}
+
+		void push_back(const value_type& val)
+		{
+			this->emplace_back(val);
+		}
+
+		void push_back(value_type&& val)
+		{
+			this->emplace_back(std::move(val));
+		}
+
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			if (_size >= _capacity)
+			{
+				// args may refer to an element: build the value before the buffer moves
+				value_type	tmp(std::forward<Args>(args)...);
+				this->_grow(_size + 1);
+				this->_construct(_start + _size, std::move(tmp));
+			}
+			else
+				this->_construct(_start + _size, std::forward<Args>(args)...);
+			_size++;
+		}
+
+		void pop_back()
+		{
+			if (_size)
+				_alloc.destroy(_start + --_size);
+		}
+
+		// Insertions append at the end and rotate the new elements into place
+		iterator insert(iterator position, const value_type& val)
+		{
+			return this->emplace(position, val);
+		}
+
+		iterator insert(iterator position, value_type&& val)
+		{
+			return this->emplace(position, std::move(val));
+		}
+
+		template <class... Args>
+		iterator emplace(iterator position, Args&&... args)
+		{
+			size_type	idx = position - this->begin();
+
+			this->emplace_back(std::forward<Args>(args)...);
+			std::rotate(_start + idx, _start + _size - 1, _start + _size);
+			return this->begin() + idx;
+		}
+
+		void insert(iterator position, size_type n, const value_type& val)
+		{
+			size_type	idx = position - this->begin();
+			size_type	old_size = _size;
+			value_type	tmp(val);
+
+			this->_grow(_size + n);
+			while (n--)
+				this->_construct(_start + _size++, tmp);
+			std::rotate(_start + idx, _start + old_size, _start + _size);
+		}
+
+		template <class InputIterator>
+		void insert(iterator position, InputIterator first, InputIterator last,
+		typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = nullptr)
+		{
+			size_type	idx = position - this->begin();
+			size_type	old_size = _size;
+
+			for (; first != last; first++)
+				this->emplace_back(*first);
+			std::rotate(_start + idx, _start + old_size, _start + _size);
+		}
+
+		iterator erase(iterator position)
+		{
+			return this->erase(position, position + 1);
+		}
+
+		iterator erase(iterator first, iterator last)
+		{
+			difference_type	diff = last - first;
+
+			if (diff > 0)
+			{
+				std::move(last, this->end(), first);
+				this->_destroy_tail(_size - diff);
+			}
+			return first;
+		}
+
+		void swap(small_vector& x)
+		{
+			if (this == &x)
+				return ;
+			if (this->_is_heap() && x._is_heap())
+			{
+				std::swap(_start, x._start);
+				std::swap(_size, x._size);
+				std::swap(_capacity, x._capacity);
+				std::swap(_alloc, x._alloc);
+				return ;
+			}
+			small_vector	tmp(std::move(x));
+			x = std::move(*this);
+			*this = std::move(tmp);
+		}
+
+		void clear()
+		{
+			this->_destroy_tail(0);
+		}
+
+		allocator_type get_allocator() const
+		{
+			return allocator_type(_alloc);
+		}
+
+	private:
+		allocator_type  _alloc;
+		pointer         _start;
+		size_type		_size;
+		size_type		_capacity;
+		alignas(T) unsigned char	_buffer[N * sizeof(T)];
+
+		pointer	_inline()
+		{
+			return reinterpret_cast<pointer>(_buffer);
+		}
+
+		bool	_is_heap() const
+		{
+			return _start != reinterpret_cast<const_pointer>(_buffer);
+		}
+
+		template <class... Args>
+		void	_construct(pointer p, Args&&... args)
+		{
+			std::allocator_traits<allocator_type>::construct(_alloc, p, std::forward<Args>(args)...);
+		}
+
+		void	_destroy_tail(size_type n)
+		{
+			while (_size > n)
+				_alloc.destroy(_start + --_size);
+		}
+
+		void	_release()
+		{
+			if (this->_is_heap())
+				_alloc.deallocate(_start, _capacity);
+			_start = this->_inline();
+			_capacity = N;
+		}
+
+		// Takes x's elements: its heap buffer as is, or its inline ones one by one.
+		// *this must be empty; x is left empty and inline.
+		void	_steal(small_vector& x)
+		{
+			if (x._is_heap())
+			{
+				_start = x._start;
+				_size = x._size;
+				_capacity = x._capacity;
+				x._start = x._inline();
+				x._size = 0;
+				x._capacity = N;
+				return ;
+			}
+			for (size_type i = 0; i < x._size; i++, _size++)
+				this->_construct(_start + i, std::move(x._start[i]));
+			x.clear();
+		}
+
+		void	_grow(size_type needed)
+		{
+			if (needed <= _capacity)
+				return ;
+			size_type	grown = ft::growth_factor<>::next(_capacity);
+			this->_reallocate(grown > needed ? grown : needed);
+		}
+
+		// Moves the elements to a new heap buffer, copying them when their move may throw
+		void	_reallocate(size_type new_capacity)
+		{
+			pointer		tmp = _alloc.allocate(new_capacity);
+			size_type	i = 0;
+
+			if (vector_traits<T>::bitwise)
+			{
+				if (_size)
+					std::memcpy(static_cast<void*>(tmp), static_cast<const void*>(_start), _size * sizeof(T));
+			}
+			else
+			{
+				try
+				{
+					for (; i < _size; i++)
+						this->_construct(tmp + i, std::move_if_noexcept(_start[i]));
+				}
+				catch (...)
+				{
+					while (i--)
+						_alloc.destroy(tmp + i);
+					_alloc.deallocate(tmp, new_capacity);
+					throw;
+				}
+				for (i = 0; i < _size; i++)
+					_alloc.destroy(_start + i);
+			}
+			if (this->_is_heap())
+				_alloc.deallocate(_start, _capacity);
+			_start = tmp;
+			_capacity = new_capacity;
+		}
+	};
+
+	template <class T, std::size_t N, class Alloc>
+	bool operator==(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+	{
+		return (ft::sequence_equal(lhs, rhs));
+	}
+
+	template <class T, std::size_t N, class Alloc>
+	bool operator!=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+	{
+		return (!(lhs == rhs));
+	}
+
+	template <class T, std::size_t N, class Alloc>
+	bool operator<(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+	{
+		return (ft::sequence_less(lhs, rhs));
+	}
+
+	template <class T, std::size_t N, class Alloc>
+	bool operator<=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+	{
+		return (!(rhs < lhs));
+	}
+
+	template <class T, std::size_t N, class Alloc>
+	bool operator>(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+	{
+		return (rhs < lhs);
+	}
+
+	template <class T, std::size_t N, class Alloc>
+	bool operator>=(const small_vector<T, N, Alloc>& lhs, const small_vector<T, N, Alloc>& rhs)
+	{
+		return (!(lhs < rhs));
+	}
+
+	template <class T, std::size_t N, class Alloc>
+	void swap(small_vector<T, N, Alloc>& x, small_vector<T, N, Alloc>& y)
+	{
+		x.swap(y);
+	}
+}
@@ -0,0 +1,112 @@
+// Ranges read through a single-pass input iterator must be read exactly once:
+// map(first, last), map::insert(first, last), the sorted_unique constructor and
+// build_parallel, with both storage policies. Exits with 1 on the first failure.
+// c++ -std=c++11 -pthread tests/map_input_iterator.cpp -o map_input_iterator && ./map_input_iterator
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include "../map.hpp"
+
+typedef ft::pair<const int, int>	pair_type;
+
+// Reads "key value" pairs from a stream, like std::istream_iterator
+class pair_reader
+{
+public:
+	typedef std::input_iterator_tag		iterator_category;
+	typedef pair_type					value_type;
+	typedef std::ptrdiff_t				difference_type;
+	typedef const value_type*			pointer;
+	typedef const value_type&			reference;
+
+	pair_reader() : _in(0), _val(0, 0) {}
+	explicit pair_reader(std::istream& in) : _in(&in), _val(0, 0) { this->_read(); }
+
+	reference operator*() const { return _val; }
+	pointer operator->() const { return &_val; }
+	pair_reader& operator++() { this->_read(); return *this; }
+	pair_reader operator++(int) { pair_reader ret(*this); this->_read(); return ret; }
+
+	bool operator==(const pair_reader& x) const { return _in == x._in; }
+	bool operator!=(const pair_reader& x) const { return _in != x._in; }
+
+private:
+	std::istream*	_in;
+	value_type		_val;
+
+	void _read()
+	{
+		int k;
+		int v;
+		if (*_in >> k >> v)
+		{
+			_val.~value_type();
+			new (&_val) value_type(k, v);
+		}
+		else
+			_in = 0;
+	}
+};
+
+static int	g_failures = 0;
+
+template <class Map>
+static void check(const char* what, const Map& m, const std::string& expected) {
+	std::ostringstream	out;
+
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		out << it->first << ":" << it->second << " ";
+	if (out.str() != expected)
+	{
+		std::cout << "FAIL " << what << ": got \"" << out.str() << "\", expected \"" << expected << "\"" << std::endl;
+		g_failures++;
+	}
+}
+
+template <class Map>
+static void run(const char* name) {
+	const std::string	sorted = "1 10 2 20 3 30 4 40";
+	const std::string	sorted_out = "1:10 2:20 3:30 4:40 ";
+	const std::string	unsorted = "3 30 1 10 2 20 1 99";
+	const std::string	unsorted_out = "1:10 2:20 3:30 ";
+
+	std::cout << name << std::endl;
+	{
+		std::istringstream in(sorted);
+		Map m((pair_reader(in)), pair_reader());
+		check("range constructor, sorted", m, sorted_out);
+	}
+	{
+		std::istringstream in(unsorted);
+		Map m((pair_reader(in)), pair_reader());
+		check("range constructor, unsorted", m, unsorted_out);
+	}
+	{
+		std::istringstream in(sorted);
+		Map m;
+		m.insert(pair_reader(in), pair_reader());
+		check("insert(first, last), sorted", m, sorted_out);
+	}
+	{
+		std::istringstream in(sorted);
+		Map m(ft::sorted_unique, pair_reader(in), pair_reader());
+		check("sorted_unique constructor", m, sorted_out);
+	}
+	{
+		std::istringstream in(unsorted);
+		Map m;
+		m.build_parallel(pair_reader(in), pair_reader(), 2);
+		check("build_parallel", m, unsorted_out);
+	}
+}
+
+int main() {
+	run<ft::map<int, int> >("rb tree");
+	run<ft::map<int, int, std::less<int>, std::allocator<pair_type>, ft::bplus_tree_policy<> > >("b+ tree");
+	if (g_failures)
+		return 1;
+	std::cout << "ok" << std::endl;
+	return 0;
+}
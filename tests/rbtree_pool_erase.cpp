@@ -0,0 +1,55 @@
+// Nodes erased from an ft::rbtree go back to its allocator, then the tree is
+// destroyed: with ft::pool_allocator (bulk slab release for trivially destructible
+// pairs, node by node otherwise) and with std::allocator. Exits with 1 on failure;
+// build it with -fsanitize=address to catch a node freed by the wrong allocator.
+// c++ -std=c++11 tests/rbtree_pool_erase.cpp -o rbtree_pool_erase && ./rbtree_pool_erase
+#include <iostream>
+#include <string>
+
+#include "../utils/rbtree.hpp"
+
+static int	g_failures = 0;
+
+template <class Tree, class Pair>
+static void run(const char* name) {
+	const int	count = 10000;
+
+	std::cout << name << std::endl;
+	{
+		Tree	t;
+
+		for (int i = 0; i < count; i++)
+			t.insert(t.getRoot(), Pair(i * 7919 % 10007, typename Pair::second_type()));
+		for (int i = 0; i < count; i += 2)
+			t.deleteNode(Pair(i * 7919 % 10007, typename Pair::second_type()));
+		if (t.size() != static_cast<std::size_t>(count / 2))
+		{
+			std::cout << "FAIL erase: size " << t.size() << ", expected " << count / 2 << std::endl;
+			g_failures++;
+		}
+		for (int i = 1; i < count; i += 2)
+			t.deleteNode(Pair(i * 7919 % 10007, typename Pair::second_type()));
+		if (t.size() != 0)
+		{
+			std::cout << "FAIL erase all: size " << t.size() << std::endl;
+			g_failures++;
+		}
+		for (int i = 0; i < count / 10; i++)
+			t.insert(t.getRoot(), Pair(i, typename Pair::second_type()));
+	}
+}
+
+int main() {
+	typedef ft::pair<int, int>			int_pair;
+	typedef ft::pair<int, std::string>	string_pair;
+
+	run<ft::rbtree<int_pair, std::less<int>, ft::node<int_pair>, ft::pool_allocator<ft::node<int_pair> > >, int_pair>
+		("pool_allocator, trivial pairs");
+	run<ft::rbtree<string_pair, std::less<int>, ft::node<string_pair>, ft::pool_allocator<ft::node<string_pair> > >, string_pair>
+		("pool_allocator, std::string pairs");
+	run<ft::rbtree<int_pair, std::less<int> >, int_pair>("std::allocator");
+	if (g_failures)
+		return 1;
+	std::cout << "ok" << std::endl;
+	return 0;
+}
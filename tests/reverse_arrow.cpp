@@ -0,0 +1,56 @@
+// operator-> through ft::reverse_iterator: on flat_map, whose iterators dereference
+// to a pair of references and hand out a proxy, and on ft::map and ft::vector,
+// whose iterators point at stored elements. Exits with 1 on the first failure.
+// c++ -std=c++11 tests/reverse_arrow.cpp -o reverse_arrow && ./reverse_arrow
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "../flat_map.hpp"
+#include "../map.hpp"
+#include "../vector.hpp"
+
+static int	g_failures = 0;
+
+static void check(const char* what, const std::string& got, const std::string& expected) {
+	if (got != expected)
+	{
+		std::cout << "FAIL " << what << ": got \"" << got << "\", expected \"" << expected << "\"" << std::endl;
+		g_failures++;
+	}
+}
+
+template <class Map>
+static void run_map(const char* name) {
+	Map					m;
+	const Map&			cm = m;
+	std::ostringstream	out;
+	std::ostringstream	cout_;
+
+	for (int i = 1; i <= 3; i++)
+		m.insert(ft::make_pair(i, i * 10));
+	for (typename Map::reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+	{
+		it->second += 1;
+		out << it->first << ":" << it->second << " ";
+	}
+	for (typename Map::const_reverse_iterator it = cm.rbegin(); it != cm.rend(); ++it)
+		cout_ << it->first << ":" << it->second << " ";
+	check(name, out.str(), "3:31 2:21 1:11 ");
+	check(name, cout_.str(), "3:31 2:21 1:11 ");
+	check(name, std::string(1, '0' + m.rbegin()->first), "3");
+}
+
+int main() {
+	run_map<ft::flat_map<int, int> >("flat_map");
+	run_map<ft::map<int, int> >("map");
+
+	ft::vector<std::string>	v;
+	v.push_back("a");
+	v.push_back("bc");
+	check("vector", std::string(1, '0' + v.rbegin()->size()), "2");
+	if (g_failures)
+		return 1;
+	std::cout << "ok" << std::endl;
+	return 0;
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+# include <cstddef>
+# include <cstring>
+# include <type_traits>
+# include <stdint.h>
+
+# if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#  define FT_BYTE_COMPARE_X86 1
+#  include <immintrin.h>
+# endif
+
+namespace ft
+{
+	// Kernels behind the comparisons of contiguous integral ranges
+	// (ft::lexicographical_compare, operator== / operator< of ft::vector).
+	// mismatch_bytes returns the offset of the first byte that differs between
+	// a and b, or n when the n bytes are equal. On x86 an AVX2 or SSE2 kernel
+	// is chosen once from the CPU the program runs on; elsewhere, and for the
+	// short tails, 8-byte words are compared and the first differing byte is
+	// found from the lowest set bit of their xor.
+	namespace byte_compare
+	{
+		typedef std::size_t	(*mismatch_fn)(const unsigned char*, const unsigned char*, std::size_t);
+
+		inline std::size_t	scalar(const unsigned char* a, const unsigned char* b, std::size_t n)
+		{
+			std::size_t	i = 0;
+
+#if (defined(__GNUC__) || defined(__clang__)) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+			for (; i + 8 <= n; i += 8)
+			{
+				uint64_t	x;
+				uint64_t	y;
+				std::memcpy(&x, a + i, 8);
+				std::memcpy(&y, b + i, 8);
+				if (x != y)
+					return i + (__builtin_ctzll(x ^ y) >> 3);
+			}
+#endif
+			for (; i < n; i++)
+				if (a[i] != b[i])
+					return i;
+			return n;
+		}
+
+#ifdef FT_BYTE_COMPARE_X86
+		__attribute__((target("sse2")))
+		inline std::size_t	sse2(const unsigned char* a, const unsigned char* b, std::size_t n)
+		{
+			std::size_t	i = 0;
+
+			for (; i + 16 <= n; i += 16)
+			{
+				__m128i	x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+				__m128i	y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+				unsigned	eq = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+				if (eq != 0xFFFFu)
+					return i + __builtin_ctz(~eq);
+			}
+			return i + scalar(a + i, b + i, n - i);
+		}
+
+		// Two 32-byte blocks per step, checked together before locating the byte
+		__attribute__((target("avx2")))
+		inline std::size_t	avx2(const unsigned char* a, const unsigned char* b, std::size_t n)
+		{
+			std::size_t	i = 0;
+
+			for (; i + 64 <= n; i += 64)
+			{
+				__m256i	x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+				__m256i	y0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+				__m256i	x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 32));
+				__m256i	y1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i + 32));
+				__m256i	e0 = _mm256_cmpeq_epi8(x0, y0);
+				__m256i	e1 = _mm256_cmpeq_epi8(x1, y1);
+				if (_mm256_movemask_epi8(_mm256_and_si256(e0, e1)) != -1)
+				{
+					unsigned	eq = static_cast<unsigned>(_mm256_movemask_epi8(e0));
+					if (eq != 0xFFFFFFFFu)
+						return i + __builtin_ctz(~eq);
+					eq = static_cast<unsigned>(_mm256_movemask_epi8(e1));
+					return i + 32 + __builtin_ctz(~eq);
+				}
+			}
+			for (; i + 32 <= n; i += 32)
+			{
+				__m256i	x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+				__m256i	y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+				unsigned	eq = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+				if (eq != 0xFFFFFFFFu)
+					return i + __builtin_ctz(~eq);
+			}
+			return i + scalar(a + i, b + i, n - i);
+		}
+#endif
+
+		inline mismatch_fn	select()
+		{
+#ifdef FT_BYTE_COMPARE_X86
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2"))
+				return &avx2;
+			if (__builtin_cpu_supports("sse2"))
+				return &sse2;
+#endif
+			return &scalar;
+		}
+	}
+
+	inline std::size_t	mismatch_bytes(const void* a, const void* b, std::size_t n)
+	{
+		const unsigned char*	x = static_cast<const unsigned char*>(a);
+		const unsigned char*	y = static_cast<const unsigned char*>(b);
+
+		// Short ranges are not worth the indirect call
+		if (n < 32)
+			return byte_compare::scalar(x, y, n);
+		static const byte_compare::mismatch_fn	kernel = byte_compare::select();
+		return kernel(x, y, n);
+	}
+
+	// Integral types compare equal exactly when their bytes do, so the first
+	// differing byte lies in the first differing element
+	template <class T>
+	struct is_byte_comparable
+	{
+		static const bool value = std::is_integral<T>::value;
+	};
+
+	template <class T>
+	bool	equal_bytes(const T* a, const T* b, std::size_t n)
+	{
+		return (!n || std::memcmp(a, b, n * sizeof(T)) == 0);
+	}
+
+	template <class T>
+	bool	less_bytes(const T* a, std::size_t n, const T* b, std::size_t m)
+	{
+		std::size_t	len = n < m ? n : m;
+		std::size_t	i = ft::mismatch_bytes(a, b, len * sizeof(T)) / sizeof(T);
+
+		if (i < len)
+			return (a[i] < b[i]);
+		return (n < m);
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <type_traits>
+#include "utils.hpp"
+
+namespace ft
+{
+
+// Position in a deque's block map: element `pos` lives at map[pos / B][pos % B].
+// B is a power of two, so the lookup is a shift and a mask.
+template <class T, std::size_t B>
+class deque_iterator
+{
+public:
+	typedef ft::random_access_iterator_tag				iterator_category;
+	typedef typename std::remove_const<T>::type			value_type;
+	typedef T*											pointer;
+	typedef T&											reference;
+	typedef ptrdiff_t									difference_type;
+	typedef value_type* const*							map_pointer;
+
+	deque_iterator() : _map(0), _pos(0) {}
+	deque_iterator(map_pointer map, std::size_t pos) : _map(map), _pos(pos) {}
+
+	operator deque_iterator<const T, B>() const
+	{ return deque_iterator<const T, B>(_map, _pos); }
+
+	map_pointer	map_base() const { return _map; }
+	std::size_t	position() const { return _pos; }
+
+	reference operator*() const { return _map[_pos / B][_pos % B]; }
+
+	pointer operator->() const { return &(**this); }
+
+	reference operator[](difference_type n) const { return *(*this + n); }
+
+	deque_iterator& operator++()
+	{
+		++_pos;
+		return *this;
+	}
+
+	deque_iterator operator++(int)
+	{
+		deque_iterator ret(*this);
+		operator++();
+		return ret;
+	}
+
+	deque_iterator& operator--()
+	{
+		--_pos;
+		return *this;
+	}
+
+	deque_iterator operator--(int)
+	{
+		deque_iterator ret(*this);
+		operator--();
+		return ret;
+	}
+
+	deque_iterator& operator+=(difference_type n)
+	{
+		_pos += n;
+		return *this;
+	}
+
+	deque_iterator& operator-=(difference_type n)
+	{
+		_pos -= n;
+		return *this;
+	}
+
+	deque_iterator operator+(difference_type n) const { return deque_iterator(_map, _pos + n); }
+	deque_iterator operator-(difference_type n) const { return deque_iterator(_map, _pos - n); }
+
+	difference_type operator-(const deque_iterator& x) const
+	{ return static_cast<difference_type>(_pos) - static_cast<difference_type>(x._pos); }
+
+	bool operator==(const deque_iterator& x) const { return _pos == x._pos; }
+	bool operator!=(const deque_iterator& x) const { return _pos != x._pos; }
+	bool operator<(const deque_iterator& x) const { return _pos < x._pos; }
+	bool operator>(const deque_iterator& x) const { return _pos > x._pos; }
+	bool operator<=(const deque_iterator& x) const { return _pos <= x._pos; }
+	bool operator>=(const deque_iterator& x) const { return _pos >= x._pos; }
+
+private:
+	map_pointer	_map;
+	std::size_t	_pos;
+};
+
+}
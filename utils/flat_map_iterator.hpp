@@ -0,0 +1,100 @@
+#pragma once
+#include "utils.hpp"
+
+namespace ft
+{
+
+// Walks the parallel key / value arrays of a flat_map in lockstep.
+// Dereferencing yields a pair of references (there is no stored pair to point at),
+// operator-> hands out a proxy that keeps that pair alive for the expression.
+template <class Key, class T>
+class flat_map_iterator
+{
+public:
+	typedef ft::random_access_iterator_tag		iterator_category;
+	typedef ft::pair<Key, T>					value_type;
+	typedef ft::pair<const Key&, T&>			reference;
+	typedef ptrdiff_t							difference_type;
+
+	struct pointer
+	{
+		reference	ref;
+		pointer(const reference& r) : ref(r) {}
+		const reference* operator->() const { return &ref; }
+	};
+
+	flat_map_iterator() : _key(0), _value(0) {}
+	flat_map_iterator(const Key* k, T* v) : _key(k), _value(v) {}
+
+	operator flat_map_iterator<Key, const T>() const
+	{ return flat_map_iterator<Key, const T>(_key, _value); }
+
+	const Key*	key_base() const { return _key; }
+	T*			value_base() const { return _value; }
+
+	reference operator*() const { return reference(*_key, *_value); }
+
+	pointer operator->() const { return pointer(**this); }
+
+	reference operator[](difference_type n) const { return reference(_key[n], _value[n]); }
+
+	flat_map_iterator& operator++()
+	{
+		++_key;
+		++_value;
+		return *this;
+	}
+
+	flat_map_iterator operator++(int)
+	{
+		flat_map_iterator ret(*this);
+		operator++();
+		return ret;
+	}
+
+	flat_map_iterator& operator--()
+	{
+		--_key;
+		--_value;
+		return *this;
+	}
+
+	flat_map_iterator operator--(int)
+	{
+		flat_map_iterator ret(*this);
+		operator--();
+		return ret;
+	}
+
+	flat_map_iterator& operator+=(difference_type n)
+	{
+		_key += n;
+		_value += n;
+		return *this;
+	}
+
+	flat_map_iterator& operator-=(difference_type n)
+	{
+		_key -= n;
+		_value -= n;
+		return *this;
+	}
+
+	flat_map_iterator operator+(difference_type n) const { return flat_map_iterator(_key + n, _value + n); }
+	flat_map_iterator operator-(difference_type n) const { return flat_map_iterator(_key - n, _value - n); }
+
+	difference_type operator-(const flat_map_iterator& x) const { return _key - x._key; }
+
+	bool operator==(const flat_map_iterator& x) const { return _key == x._key; }
+	bool operator!=(const flat_map_iterator& x) const { return _key != x._key; }
+	bool operator<(const flat_map_iterator& x) const { return _key < x._key; }
+	bool operator>(const flat_map_iterator& x) const { return _key > x._key; }
+	bool operator<=(const flat_map_iterator& x) const { return _key <= x._key; }
+	bool operator>=(const flat_map_iterator& x) const { return _key >= x._key; }
+
+private:
+	const Key*	_key;
+	T*			_value;
+};
+
+}
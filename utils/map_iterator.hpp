@@ -29,23 +29,9 @@ public:
 	{
 	}
 
-	binaryiterator(const binaryiterator& x) : _ptr(x._ptr)
-	{
-	}
-
-	binaryiterator& operator=(const binaryiterator& x)
-	{
-		if (this == &x)
-			return (*this);
-		this->_ptr = x._ptr;
-		return (*this);
-	}
-
     operator binaryiterator<const T, 1> () const
 	{ return (binaryiterator<const T, 1>(this->_ptr)); }
 
-	virtual ~binaryiterator() {}
-
 	reference operator*() const
 	{ return static_cast<linkPtr>(_ptr)->data; }
 
@@ -58,20 +44,20 @@ public:
 
 	self& operator++(void)
 	{
-		if ((_ptr == _ptr->parent->right || _ptr->parent->isnull) && _ptr->right->isnull)
+		if ((_ptr == _ptr->parent->right || _ptr->parent->isnull()) && _ptr->right->isnull())
 		{
 			_ptr = _ptr->right;
 			return *this;
 		}
-		if (_ptr->isnull && !_ptr->isrend)
+		if (_ptr->isnull() && !_ptr->isrend())
 		{
 			_ptr = _ptr->parent;
 			return *this;
 		}
-		if (!_ptr->right->isnull)
+		if (!_ptr->right->isnull())
 		{
 			_ptr = _ptr->right;
-			while (!_ptr->left->isnull)
+			while (!_ptr->left->isnull())
 				_ptr = _ptr->left;
 		}
 		else
@@ -97,20 +83,20 @@ public:
 
 	self& operator--(void)
 	{
-		if (_ptr->isnull && !_ptr->isrend)
+		if (_ptr->isnull() && !_ptr->isrend())
 		{
 			_ptr = _ptr->parent;
 			return *this;
 		}
-		if (_ptr->left->isrend && !_ptr->parent->isnull)
+		if (_ptr->left->isrend() && !_ptr->parent->isnull())
 		{
 			_ptr = _ptr->left;
 			return *this;
 		}
-		else if (!_ptr->left->isnull)
+		else if (!_ptr->left->isnull())
 		{
 			_ptr = _ptr->left;
-			while (!_ptr->right->isnull)
+			while (!_ptr->right->isnull())
 				_ptr = _ptr->right;
 		}
 		else
@@ -0,0 +1,163 @@
+#pragma once
+
+# include <cstddef>
+# include <limits>
+# include <new>
+# include <sys/mman.h>
+# include <unistd.h>
+# include "utils.hpp"
+
+namespace ft
+{
+	// Allocator for very large buffers. Requests of at least Threshold bytes
+	// are served by anonymous mmap, rounded to whole pages, with a transparent
+	// huge page hint, and unmapped on deallocate. Smaller ones go to operator new.
+	// ft::vector grows its mapped buffer of trivially copyable elements with
+	// mremap instead of copying it:
+	//   ft::vector<Buffer, ft::mmap_allocator<Buffer> >
+	template <class T, std::size_t Threshold = (1 << 20)>
+	class mmap_allocator
+	{
+	public:
+		typedef T					value_type;
+		typedef T*					pointer;
+		typedef const T*			const_pointer;
+		typedef T&					reference;
+		typedef const T&			const_reference;
+		typedef std::size_t			size_type;
+		typedef std::ptrdiff_t		difference_type;
+
+		template <class U>
+		struct rebind { typedef mmap_allocator<U, Threshold> other; };
+
+		mmap_allocator() {}
+		mmap_allocator(const mmap_allocator&) {}
+		template <class U>
+		mmap_allocator(const mmap_allocator<U, Threshold>&) {}
+		~mmap_allocator() {}
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		pointer allocate(size_type n, const void* hint = 0)
+		{
+			(void)hint;
+			if (n > this->max_size())
+				throw std::bad_alloc();
+			if (!_is_mapped(n))
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+			return static_cast<pointer>(_map(_round(n * sizeof(T))));
+		}
+
+		void deallocate(pointer p, size_type n)
+		{
+			if (!_is_mapped(n))
+			{
+				::operator delete(p);
+				return ;
+			}
+			munmap(static_cast<void*>(p), _round(n * sizeof(T)));
+		}
+
+		// Grows or shrinks a mapped buffer from old_n to new_n elements, moving
+		// its pages rather than its bytes. Returns 0 when either size is not
+		// mapped (or mremap is unavailable): p is then untouched.
+		pointer reallocate(pointer p, size_type old_n, size_type new_n)
+		{
+			if (!_is_mapped(old_n) || !_is_mapped(new_n) || new_n > this->max_size())
+				return 0;
+#ifdef MREMAP_MAYMOVE
+			size_type	len = _round(new_n * sizeof(T));
+			void*		ret = mremap(static_cast<void*>(p), _round(old_n * sizeof(T)), len, MREMAP_MAYMOVE);
+			if (ret == MAP_FAILED)
+				throw std::bad_alloc();
+			_advise(ret, len);
+			return static_cast<pointer>(ret);
+#else
+			(void)p;
+			return 0;
+#endif
+		}
+
+		size_type max_size() const
+		{
+			return std::numeric_limits<size_type>::max() / sizeof(T) / 2;
+		}
+
+		void construct(pointer p, const_reference val)
+		{
+			new(static_cast<void*>(p)) T(val);
+		}
+
+		void destroy(pointer p)
+		{
+			p->~T();
+		}
+
+		template <class U>
+		bool operator==(const mmap_allocator<U, Threshold>&) const { return true; }
+
+		template <class U>
+		bool operator!=(const mmap_allocator<U, Threshold>&) const { return false; }
+
+	private:
+		static const std::size_t huge_page = 2 << 20;
+
+		static bool _is_mapped(size_type n)
+		{
+			return n * sizeof(T) >= Threshold;
+		}
+
+		static size_type _round(size_type bytes)
+		{
+			size_type page = static_cast<size_type>(sysconf(_SC_PAGESIZE));
+			return (bytes + page - 1) / page * page;
+		}
+
+		static void _advise(void* p, size_type len)
+		{
+#ifdef MADV_HUGEPAGE
+			if (len >= huge_page)
+				madvise(p, len, MADV_HUGEPAGE);
+#else
+			(void)p;
+			(void)len;
+#endif
+		}
+
+		// Mappings of a huge page or more start on a huge page boundary so the
+		// kernel can back them with huge pages from the first byte
+		static void* _map(size_type len)
+		{
+			size_type	extra = len >= huge_page ? huge_page : 0;
+			char*		raw = static_cast<char*>(mmap(0, len + extra, PROT_READ | PROT_WRITE,
+									MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+			if (raw == MAP_FAILED)
+				throw std::bad_alloc();
+			if (extra)
+			{
+				size_type	addr = reinterpret_cast<size_type>(raw);
+				size_type	head = (huge_page - addr % huge_page) % huge_page;
+				if (head)
+					munmap(raw, head);
+				if (extra - head)
+					munmap(raw + head + len, extra - head);
+				raw += head;
+			}
+			_advise(raw, len);
+			return raw;
+		}
+	};
+
+	// Enables the ft::vector reallocation hook declared in utils.hpp
+	template <class T, std::size_t Threshold>
+	struct remap_traits<mmap_allocator<T, Threshold> >
+	{
+		static const bool enabled = true;
+
+		static T* remap(mmap_allocator<T, Threshold>& alloc, T* p, std::size_t old_n, std::size_t new_n)
+		{
+			return alloc.reallocate(p, old_n, new_n);
+		}
+	};
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+# include <algorithm>
+# include <atomic>
+# include <cstddef>
+# include <exception>
+# include <iterator>
+# include <thread>
+# include <utility>
+# include <vector>
+
+namespace ft
+{
+	// Runs f(0) ... f(tasks - 1) on up to `threads` threads, the calling one
+	// included (0 means one per core). Threads take the next task from a shared
+	// counter, so whoever finishes early picks up the remaining work. The first
+	// exception thrown by a task is rethrown once every thread has stopped.
+	template <class F>
+	void parallel_for(std::size_t tasks, unsigned threads, F f)
+	{
+		std::atomic<std::size_t>	next(0);
+		std::atomic<bool>			failed(false);
+		std::exception_ptr			error;
+		std::vector<std::thread>	pool;
+
+		if (threads == 0)
+			threads = std::thread::hardware_concurrency();
+		if (threads > tasks)
+			threads = static_cast<unsigned>(tasks);
+		auto work = [&]() {
+			for (std::size_t i; !failed.load(std::memory_order_relaxed)
+					&& (i = next.fetch_add(1, std::memory_order_relaxed)) < tasks; )
+			{
+				try
+				{
+					f(i);
+				}
+				catch (...)
+				{
+					if (!failed.exchange(true))
+						error = std::current_exception();
+				}
+			}
+		};
+		// Fewer threads than asked for if the system refuses more
+		try
+		{
+			for (unsigned t = 1; t < threads; t++)
+				pool.push_back(std::thread(work));
+		}
+		catch (...)
+		{
+		}
+		work();
+		for (std::size_t t = 0; t < pool.size(); t++)
+			pool[t].join();
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	// Sorts [first, last) stably with less on `threads` threads, then keeps only
+	// the first element of every run of equivalent ones. Chunks are sorted and
+	// deduplicated in parallel, then merged pairwise, each round in parallel;
+	// std::merge takes from the left run on ties, so the input order of
+	// equivalent elements survives. Returns the new end.
+	template <class RandomIt, class Less>
+	RandomIt parallel_sort_unique(RandomIt first, RandomIt last, Less less, unsigned threads = 0)
+	{
+		typedef typename std::iterator_traits<RandomIt>::value_type	value_type;
+		typedef std::pair<std::size_t, std::size_t>					run_type;
+
+		// Below this many elements per chunk, a thread costs more than it saves
+		const std::size_t	min_chunk = 4096;
+		std::size_t			n = last - first;
+
+		if (threads == 0)
+			threads = std::thread::hardware_concurrency();
+		if (threads == 0)
+			threads = 1;
+		std::size_t	chunks = threads * 4;
+		if (chunks > n / min_chunk)
+			chunks = n / min_chunk ? n / min_chunk : 1;
+
+		auto equivalent = [&less](const value_type& a, const value_type& b) { return !less(a, b); };
+		std::vector<value_type>	src(first, last);
+		std::vector<value_type>	dst(n);
+		std::vector<run_type>	runs(chunks);
+
+		ft::parallel_for(chunks, threads, [&](std::size_t i) {
+			std::size_t b = n * i / chunks;
+			std::size_t e = n * (i + 1) / chunks;
+			std::stable_sort(src.begin() + b, src.begin() + e, less);
+			e = std::unique(src.begin() + b, src.begin() + e, equivalent) - src.begin();
+			runs[i] = run_type(b, e);
+		});
+		while (runs.size() > 1)
+		{
+			std::size_t					pairs = (runs.size() + 1) / 2;
+			std::vector<run_type>		merged(pairs);
+
+			for (std::size_t j = 0, off = 0; j < pairs; j++)
+			{
+				std::size_t len = runs[2 * j].second - runs[2 * j].first;
+				if (2 * j + 1 < runs.size())
+					len += runs[2 * j + 1].second - runs[2 * j + 1].first;
+				merged[j] = run_type(off, off + len);
+				off += len;
+			}
+			ft::parallel_for(pairs, threads, [&](std::size_t j) {
+				const run_type&	a = runs[2 * j];
+				if (2 * j + 1 < runs.size())
+				{
+					const run_type& b = runs[2 * j + 1];
+					std::merge(src.begin() + a.first, src.begin() + a.second,
+						src.begin() + b.first, src.begin() + b.second,
+						dst.begin() + merged[j].first, less);
+				}
+				else
+					std::copy(src.begin() + a.first, src.begin() + a.second, dst.begin() + merged[j].first);
+			});
+			src.swap(dst);
+			runs.swap(merged);
+		}
+		// Equivalents from different chunks are now neighbours, in input order
+		typename std::vector<value_type>::iterator end = std::unique(src.begin() + runs[0].first,
+				src.begin() + runs[0].second, equivalent);
+		return std::copy(src.begin() + runs[0].first, end, first);
+	}
+}
@@ -0,0 +1,206 @@
+#pragma once
+
+# include <cstddef>
+# include <limits>
+# include <new>
+
+namespace ft
+{
+	// Allocator that carves single objects out of large slabs and recycles
+	// them through a free list. Copies share the same pool (refcounted), so
+	// memory allocated by one copy can be released by another.
+	// Usable as the Alloc parameter of ft::map:
+	//   ft::map<int, int, std::less<int>, ft::pool_allocator<ft::pair<const int, int> > >
+	template <class T, std::size_t SlabBytes = 65536>
+	class pool_allocator
+	{
+	public:
+		typedef T					value_type;
+		typedef T*					pointer;
+		typedef const T*			const_pointer;
+		typedef T&					reference;
+		typedef const T&			const_reference;
+		typedef std::size_t			size_type;
+		typedef std::ptrdiff_t		difference_type;
+
+		template <class U>
+		struct rebind { typedef pool_allocator<U, SlabBytes> other; };
+
+		pool_allocator() : _pool(new pool_type()) {}
+
+		pool_allocator(const pool_allocator& x) : _pool(x._pool)
+		{
+			_pool->refs++;
+		}
+
+		// A rebound copy serves a different object size, so it gets its own pool
+		template <class U>
+		pool_allocator(const pool_allocator<U, SlabBytes>&) : _pool(new pool_type()) {}
+
+		pool_allocator& operator=(const pool_allocator& x)
+		{
+			if (_pool != x._pool)
+			{
+				x._pool->refs++;
+				_release_ref();
+				_pool = x._pool;
+			}
+			return *this;
+		}
+
+		~pool_allocator()
+		{
+			_release_ref();
+		}
+
+		pointer address(reference x) const { return &x; }
+		const_pointer address(const_reference x) const { return &x; }
+
+		pointer allocate(size_type n, const void* hint = 0)
+		{
+			(void)hint;
+			if (n != 1)
+				return static_cast<pointer>(::operator new(n * sizeof(T)));
+			if (_pool->free_list)
+			{
+				free_node* ret = _pool->free_list;
+				_pool->free_list = ret->next;
+				return reinterpret_cast<pointer>(ret);
+			}
+			if (_pool->cur == _pool->end)
+				_new_slab();
+			pointer ret = reinterpret_cast<pointer>(_pool->cur);
+			_pool->cur += node_size;
+			return ret;
+		}
+
+		void deallocate(pointer p, size_type n)
+		{
+			if (n != 1)
+			{
+				::operator delete(p);
+				return ;
+			}
+			free_node* node = reinterpret_cast<free_node*>(p);
+			node->next = _pool->free_list;
+			_pool->free_list = node;
+		}
+
+		// Drops every slab at once without touching the objects inside.
+		// Only done when no other copy shares the pool, returns false otherwise.
+		bool release()
+		{
+			if (_pool->refs != 1)
+				return false;
+			_pool->clear();
+			return true;
+		}
+
+		size_type max_size() const
+		{
+			return std::numeric_limits<size_type>::max() / sizeof(T);
+		}
+
+		void construct(pointer p, const_reference val)
+		{
+			new(static_cast<void*>(p)) T(val);
+		}
+
+		void destroy(pointer p)
+		{
+			p->~T();
+		}
+
+		template <class U, std::size_t S>
+		friend class pool_allocator;
+
+		template <class U>
+		bool operator==(const pool_allocator<U, SlabBytes>& x) const
+		{
+			return static_cast<const void*>(_pool) == static_cast<const void*>(x._pool);
+		}
+
+		template <class U>
+		bool operator!=(const pool_allocator<U, SlabBytes>& x) const
+		{
+			return !(*this == x);
+		}
+
+	private:
+		struct free_node
+		{
+			free_node*	next;
+		};
+
+		struct slab
+		{
+			slab*		next;
+		};
+
+		static const std::size_t node_align = (alignof(T) > alignof(free_node*)) ? alignof(T) : alignof(free_node*);
+		static const std::size_t raw_size = (sizeof(T) > sizeof(free_node)) ? sizeof(T) : sizeof(free_node);
+		static const std::size_t node_size = (raw_size + node_align - 1) / node_align * node_align;
+		static const std::size_t header_size = (sizeof(slab) + node_align - 1) / node_align * node_align;
+		static const std::size_t slab_nodes = (SlabBytes / node_size) ? (SlabBytes / node_size) : 1;
+
+		struct pool_type
+		{
+			slab*		slabs;
+			free_node*	free_list;
+			char*		cur;
+			char*		end;
+			std::size_t	refs;
+
+			pool_type() : slabs(0), free_list(0), cur(0), end(0), refs(1) {}
+
+			~pool_type()
+			{
+				clear();
+			}
+
+			void clear()
+			{
+				while (slabs)
+				{
+					slab* next = slabs->next;
+					::operator delete(slabs);
+					slabs = next;
+				}
+				free_list = 0;
+				cur = 0;
+				end = 0;
+			}
+		};
+
+		pool_type*	_pool;
+
+		void _new_slab()
+		{
+			char* mem = static_cast<char*>(::operator new(header_size + slab_nodes * node_size));
+			slab* s = reinterpret_cast<slab*>(mem);
+			s->next = _pool->slabs;
+			_pool->slabs = s;
+			_pool->cur = mem + header_size;
+			_pool->end = _pool->cur + slab_nodes * node_size;
+		}
+
+		void _release_ref()
+		{
+			if (--_pool->refs == 0)
+				delete _pool;
+		}
+	};
+
+	// Bulk release hook used by the trees: a no-op for ordinary allocators
+	template <class Alloc>
+	bool release_nodes(Alloc&)
+	{
+		return false;
+	}
+
+	template <class T, std::size_t SlabBytes>
+	bool release_nodes(pool_allocator<T, SlabBytes>& alloc)
+	{
+		return alloc.release();
+	}
+}
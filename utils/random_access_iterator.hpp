@@ -13,37 +13,22 @@ namespace ft
             typedef typename ft::iterator<ft::random_access_iterator_tag, T>::difference_type       difference_type;
             typedef T*               pointer;
             typedef T&             reference;
-            
+            typedef ft::contiguous_iterator_tag     iterator_concept;
+
+            // Copy, assignment and destruction are the implicit ones: the iterator
+            // is a single trivially copyable pointer that travels in a register
             random_access_iterator(void) : _ptr(nullptr)
             {}
 
             random_access_iterator(pointer ptr) : _ptr(ptr)
             {}
 
-            random_access_iterator(const random_access_iterator& x) : _ptr(x._ptr)
-            {}
-
-            // operator random_access_iterator<const value_type>() const {
-            //     random_access_iterator<const value_type> out(_ptr);
-            //     return out;
-            // }
-
-            random_access_iterator &operator=(const random_access_iterator& x)
-            {
-                if (this == &x)
-                    return (*this);
-                this->_ptr = x._ptr;
-                return (*this);
-            }
-
-            virtual ~random_access_iterator() {}
-
             pointer base() const
             { return (this->_ptr); }
 
             reference operator*(void) const { return (*_ptr); }
 
-            pointer operator->(void) { return &(this->operator*()); }
+            pointer operator->(void) const { return (_ptr); }
 
             random_access_iterator& operator++(void)
             {
@@ -87,7 +72,7 @@ namespace ft
                 return (*this);
             }
 
-            reference operator[](difference_type n) { return (*(operator+(n))); }
+            reference operator[](difference_type n) const { return (_ptr[n]); }
 
             operator random_access_iterator<const T> () const
             { return (random_access_iterator<const T>(this->_ptr)); }
@@ -218,6 +203,12 @@ namespace ft
         return (lhs.base() - rhs.base());
     }
 
+    template <typename T>
+    T* to_address(const ft::random_access_iterator<T>& it)
+    {
+        return (it.base());
+    }
+
     template <typename T>
     std::ostream& operator<<(std::ostream& out, const ft::random_access_iterator<T>& rai)
     {
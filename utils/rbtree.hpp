@@ -1,6 +1,8 @@
 #pragma once
 #include <memory>
+#include <type_traits>
 #include "utils.hpp"
+#include "pool_allocator.hpp"
 
 namespace ft
 {
@@ -20,15 +22,15 @@ public:
 	{
 		TNULL = _alloc.allocate(1);
 		_alloc.construct(TNULL, Node());
-		TNULL->color = BLACK;
-		TNULL->isnull = true;
+		TNULL->set_color(BLACK);
+		TNULL->set_isnull(true);
 		TNULL->left = TNULL;
 		TNULL->right = TNULL;
 		TNULL->parent = TNULL;
 		root = TNULL;
 		REND = this->createNode();
-		REND->isnull = true;
-		REND->isrend = true;
+		REND->set_isnull(true);
+		REND->set_isrend(true);
 		REND->left = nullptr;
 		TNULL->left = REND;
 	}
@@ -38,11 +40,11 @@ public:
 		NodePtr newNode = _alloc.allocate(1);
 
 		_alloc.construct(newNode, Node());
-		newNode->color = BLACK;
+		newNode->set_color(BLACK);
 		newNode->left = TNULL;
 		newNode->right = TNULL;
 		newNode->parent = newNode;
-		newNode->isrend = false;
+		newNode->set_isrend(false);
 		return (newNode);
 	}
 
@@ -51,19 +53,26 @@ public:
 		NodePtr newNode = _alloc.allocate(1);
 
 		_alloc.construct(newNode, Node(val));
-		newNode->color = BLACK;
+		newNode->set_color(BLACK);
 		newNode->left = TNULL;
 		newNode->right = TNULL;
 		newNode->parent = newNode;
-		newNode->isrend = false;
+		newNode->set_isrend(false);
 		return (newNode);
 	}
 
+	// Slabs of a private node pool are dropped at once when the pairs have
+	// nothing to destroy; otherwise every node, sentinels included, goes
+	// back to the allocator it came from
 	~rbtree()
 	{
+		if (std::is_trivially_destructible<Pair>::value && ft::release_nodes(_alloc))
+			return ;
 		deleteAll(this->root);
-		delete TNULL;
-		delete REND;
+		_alloc.destroy(TNULL);
+		_alloc.deallocate(TNULL, 1);
+		_alloc.destroy(REND);
+		_alloc.deallocate(REND, 1);
 	}
 
 	size_type size() const
@@ -93,25 +102,25 @@ public:
 
 	NodePtr min(NodePtr node) const
 	{
-		while (!node->left->isnull)
+		while (!node->left->isnull())
 			node = node->left;
 		return node;
 	}
 
 	NodePtr max(NodePtr node) const
 	{
-		while (!node->right->isnull)
+		while (!node->right->isnull())
 			node = node->right;
 		return node;
 	}
 
 	NodePtr successor(NodePtr x)
 	{
-		if (!x->right->isnull)
+		if (!x->right->isnull())
 			return min(x->right);
 
 		NodePtr y = x->parent;
-		while (!y->isnull && x == y->right)
+		while (!y->isnull() && x == y->right)
 		{
 			x = y;
 			y = y->parent;
@@ -121,11 +130,11 @@ public:
 
 	NodePtr predecessor(NodePtr x)
 	{
-		if (!x->left->isnull)
+		if (!x->left->isnull())
 			return max(x->left);
 
 		NodePtr y = x->parent;
-		while (!y->isnull && x == y->left)
+		while (!y->isnull() && x == y->left)
 		{
 			x = y;
 			y = y->parent;
@@ -139,10 +148,10 @@ public:
 		NodePtr y = x->right;
 
 		x->right = y->left;
-		if (!y->left->isnull)
+		if (!y->left->isnull())
 			y->left->parent = x;
 		y->parent = x->parent;
-		if (x->parent->isnull)
+		if (x->parent->isnull())
 			this->root = y;
 		else if (x == x->parent->left)
 			x->parent->left = y;
@@ -157,7 +166,7 @@ public:
 		NodePtr y = x->left;
 
 		x->left = y->right;
-		if (!y->left->isnull)
+		if (!y->left->isnull())
 			y->right->parent = x;
 		y->parent = x->parent;
 		if (x->parent == TNULL)
@@ -174,12 +183,12 @@ public:
 	{
 		NodePtr node = this->createNode(val);
 
-		node->color = RED;
+		node->set_color(RED);
 
 		NodePtr y = TNULL;
 		NodePtr x = begin;
 
-		while (!x->isnull)
+		while (!x->isnull())
 		{
 			y = x;
 			if (comparator(node->data.first, x->data.first))
@@ -189,16 +198,16 @@ public:
 		}
 
 		node->parent = y;
-		if (y->isnull)
+		if (y->isnull())
 			root = node;
 		else if (comparator(node->data.first, y->data.first))
 			y->left = node;
 		else
 			y->right = node;
 
-		if (node->parent->isnull)
+		if (node->parent->isnull())
 		{
-			node->color = BLACK;
+			node->set_color(BLACK);
 			TNULL->parent = this->max(this->root);
 			this->min(this->root)->left = REND;
 			REND->parent = this->min(this->root);
@@ -206,7 +215,7 @@ public:
 			return node;
 		}
 
-		if (node->parent->parent->isnull)
+		if (node->parent->parent->isnull())
 		{
 			TNULL->parent = this->max(this->root);
 			this->min(this->root)->left = REND;
@@ -259,14 +268,27 @@ public:
 			print(this->root, "", true);
 	}
 
+	// Frees the subtree without recursion or rebalancing: the left child is
+	// rotated up while there is one, then the node is freed and its right
+	// subtree takes its place. Linear time, constant extra space.
 	void deleteAll(NodePtr node)
 	{
-		if (!node->isnull)
+		while (!node->isnull())
 		{
-			deleteAll(node->left);
-			deleteAll(node->right);
-			_alloc.destroy(node);
-			_alloc.deallocate(node, 1);
+			if (!node->left->isnull())
+			{
+				NodePtr l = node->left;
+				node->left = l->right;
+				l->right = node;
+				node = l;
+			}
+			else
+			{
+				NodePtr next = node->right;
+				_alloc.destroy(node);
+				_alloc.deallocate(node, 1);
+				node = next;
+			}
 		}
 		root = TNULL;
 	}
@@ -282,7 +304,7 @@ private:
 
 	void prefix(NodePtr node)
 	{
-		if (!node->isnull)
+		if (!node->isnull())
 		{
 			std::cout << node->data << " ";
 			prefix(node->left);
@@ -292,7 +314,7 @@ private:
 
 	void infix(NodePtr node)
 	{
-		if (!node->isnull)
+		if (!node->isnull())
 		{
 			infix(node->left);
 			std::cout << node->data << " ";
@@ -302,7 +324,7 @@ private:
 
 	NodePtr search(NodePtr node, key_type key)
 	{
-		if (node->isnull || key == node->data.first)
+		if (node->isnull() || key == node->data.first)
 			return node;
 
 		if (comparator(key, node->data.first))
@@ -315,37 +337,37 @@ private:
 	{
 		NodePtr s;
 
-		while (x != root && x->color == BLACK)
+		while (x != root && x->color() == BLACK)
 		{
 			if (x == x->parent->left)
 			{
 				s = x->parent->right;
-				if (s->color == RED)
+				if (s->color() == RED)
 				{
-					s->color = BLACK;
-					x->parent->color = RED;
+					s->set_color(BLACK);
+					x->parent->set_color(RED);
 					leftRotate(x->parent);
 					s = x->parent->right;
 				}
 
-				if (s->left->color == BLACK && s->right->color == BLACK)
+				if (s->left->color() == BLACK && s->right->color() == BLACK)
 				{
-					s->color = RED;
+					s->set_color(RED);
 					x = x->parent;
 				}
 				else
 				{
-					if (s->right->color == BLACK)
+					if (s->right->color() == BLACK)
 					{
-						s->left->color = BLACK;
-						s->color = RED;
+						s->left->set_color(BLACK);
+						s->set_color(RED);
 						rightRotate(s);
 						s = x->parent->right;
 					}
 
-					s->color = x->parent->color;
-					x->parent->color = BLACK;
-					s->right->color = BLACK;
+					s->set_color(x->parent->color());
+					x->parent->set_color(BLACK);
+					s->right->set_color(BLACK);
 					leftRotate(x->parent);
 					x = root;
 				}
@@ -353,42 +375,42 @@ private:
 			else
 			{
 				s = x->parent->left;
-				if (s->color == RED)
+				if (s->color() == RED)
 				{
-					s->color = BLACK;
-					x->parent->color = RED;
+					s->set_color(BLACK);
+					x->parent->set_color(RED);
 					rightRotate(x->parent);
 					s = x->parent->left;
 				}
 
-				if (s->right->color == BLACK && s->right->color == BLACK)
+				if (s->left->color() == BLACK && s->right->color() == BLACK)
 				{
-					s->color = RED;
+					s->set_color(RED);
 					x = x->parent;
 				}
 				else
 				{
-					if (s->left->color == BLACK)
+					if (s->left->color() == BLACK)
 					{
-						s->right->color = BLACK;
-						s->color = RED;
+						s->right->set_color(BLACK);
+						s->set_color(RED);
 						leftRotate(s);
 						s = x->parent->left;
 					}
-					s->color = x->parent->color;
-					x->parent->color = BLACK;
-					s->left->color = BLACK;
+					s->set_color(x->parent->color());
+					x->parent->set_color(BLACK);
+					s->left->set_color(BLACK);
 					rightRotate(x->parent);
 					x = root;
 				}
 			}
 		}
-		x->color = BLACK;
+		x->set_color(BLACK);
 	}
 
 	void swap(NodePtr u, NodePtr v)
 	{
-		if (u->parent->isnull)
+		if (u->parent->isnull())
 			root = v;
 		else if (u == u->parent->left)
 			u->parent->left = v;
@@ -403,7 +425,7 @@ private:
 		NodePtr z = TNULL;
 		NodePtr x, y;
 
-		while (!node->isnull)
+		while (!node->isnull())
 		{
 			if (node->data.first == k)
 				z = node;
@@ -414,20 +436,20 @@ private:
 				node = node->left;
 		}
 
-		if (z->isnull)
+		if (z->isnull())
 		{
 			std::cout << "Key not found in the tree" << std::endl;
 			return;
 		}
 
 		y = z;
-		colors y_original_color = y->color;
-		if (z->left->isnull)
+		colors y_original_color = y->color();
+		if (z->left->isnull())
 		{
 			x = z->right;
 			swap(z, z->right);
 		}
-		else if (z->right->isnull)
+		else if (z->right->isnull())
 		{
 			x = z->left;
 			swap(z, z->left);
@@ -435,7 +457,7 @@ private:
 		else
 		{
 			y = min(z->right);
-			y_original_color = y->color;
+			y_original_color = y->color();
 			x = y->right;
 			if (y->parent == z)
 				x->parent = y;
@@ -449,9 +471,10 @@ private:
 			swap(z, y);
 			y->left = z->left;
 			y->left->parent = y;
-			y->color = z->color;
+			y->set_color(z->color());
 		}
-		delete z;
+		_alloc.destroy(z);
+		_alloc.deallocate(z, 1);
 		if (y_original_color == BLACK)
 			deleteFix(x);
 		_size--;
@@ -461,16 +484,16 @@ private:
 	{
 		NodePtr u;
 
-		while (k->parent->color == RED)
+		while (k->parent->color() == RED)
 		{
 			if (k->parent == k->parent->parent->right)
 			{
 				u = k->parent->parent->left;
-				if (u->color == RED)
+				if (u->color() == RED)
 				{
-					u->color = BLACK;
-					k->parent->color = BLACK;
-					k->parent->parent->color = RED;
+					u->set_color(BLACK);
+					k->parent->set_color(BLACK);
+					k->parent->parent->set_color(RED);
 					k = k->parent->parent;
 				}
 				else
@@ -480,8 +503,8 @@ private:
 						k = k->parent;
 						rightRotate(k);
 					}
-					k->parent->color = BLACK;
-					k->parent->parent->color = RED;
+					k->parent->set_color(BLACK);
+					k->parent->parent->set_color(RED);
 					leftRotate(k->parent->parent);
 				}
 			}
@@ -489,11 +512,11 @@ private:
 			{
 				u = k->parent->parent->right;
 
-				if (u->color == RED)
+				if (u->color() == RED)
 				{
-					u->color = BLACK;
-					k->parent->color = BLACK;
-					k->parent->parent->color = RED;
+					u->set_color(BLACK);
+					k->parent->set_color(BLACK);
+					k->parent->parent->set_color(RED);
 					k = k->parent->parent;
 				}
 				else
@@ -503,19 +526,19 @@ private:
 						k = k->parent;
 						leftRotate(k);
 					}
-					k->parent->color = BLACK;
-					k->parent->parent->color = RED;
+					k->parent->set_color(BLACK);
+					k->parent->parent->set_color(RED);
 					rightRotate(k->parent->parent);
 				}
 			}
 			if (k == root)
 				break;
 		}
-		root->color = BLACK;
+		root->set_color(BLACK);
 	}
 
 	void print(NodePtr root, std::string indent, bool last) {
-		if (!root->isnull)
+		if (!root->isnull())
 		{
 			std::cout << indent;
 			if (last)
@@ -529,7 +552,7 @@ private:
 				indent += "|  ";
 			}
 
-			std::string sColor = root->color ? "RED" : "BLACK";
+			std::string sColor = root->color() ? "RED" : "BLACK";
 			std::cout << root->data << "(" << sColor << ")" << std::endl;
 			print(root->left, indent, false);
 			print(root->right, indent, true);
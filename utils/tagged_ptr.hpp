@@ -0,0 +1,60 @@
+#pragma once
+
+# include <cstddef>
+# include <stdint.h>
+
+namespace ft
+{
+	// Pointer carrying Bits flags in its low bits, which are always zero for
+	// a T aligned on at least 1 << Bits bytes. It converts to T* and is
+	// assigned from T* like the plain pointer it replaces. Assigning only
+	// changes the address: the flags belong to the object holding the
+	// pointer, and are copied only with it (copy construction).
+	//   ft::tagged_ptr<Node, 1>	parent;		// parent + colour bit
+	//   n->parent = p;							// colour unchanged
+	//   n->parent.set_tag(1);
+	template <class T, unsigned Bits = 1>
+	class tagged_ptr
+	{
+	public:
+		static const uintptr_t	tag_mask = (static_cast<uintptr_t>(1) << Bits) - 1;
+
+		tagged_ptr() : _bits(0) {}
+
+		explicit tagged_ptr(T* p, uintptr_t tag = 0) : _bits(_address(p) | (tag & tag_mask)) {}
+
+		tagged_ptr(const tagged_ptr&) = default;
+
+		tagged_ptr& operator=(const tagged_ptr& x) { return *this = x.get(); }
+
+		tagged_ptr& operator=(T* p)
+		{
+			_bits = _address(p) | (_bits & tag_mask);
+			return *this;
+		}
+
+		T*			get() const { return reinterpret_cast<T*>(_bits & ~tag_mask); }
+		operator	T*() const { return this->get(); }
+		T*			operator->() const { return this->get(); }
+		T&			operator*() const { return *this->get(); }
+
+		uintptr_t	tag() const { return _bits & tag_mask; }
+		void		set_tag(uintptr_t tag) { _bits = (_bits & ~tag_mask) | (tag & tag_mask); }
+
+		bool		tag_bit(unsigned i) const { return (_bits >> i) & 1; }
+		void		set_tag_bit(unsigned i, bool on)
+		{
+			_bits = on ? (_bits | (static_cast<uintptr_t>(1) << i)) : (_bits & ~(static_cast<uintptr_t>(1) << i));
+		}
+
+	private:
+		uintptr_t	_bits;
+
+		// Checked here, where T is complete (a node points to its own type)
+		static uintptr_t	_address(T* p)
+		{
+			static_assert(alignof(T) > tag_mask, "tagged_ptr: T is not aligned enough for its tag bits");
+			return reinterpret_cast<uintptr_t>(p);
+		}
+	};
+}
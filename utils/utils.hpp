@@ -5,7 +5,11 @@
 # include <sstream>
 # include <typeinfo>
 # include <iostream>
+# include <iterator>
+# include <type_traits>
 # include "pair.hpp"
+# include "byte_compare.hpp"
+# include "tagged_ptr.hpp"
 
 namespace ft
 {
@@ -104,6 +108,16 @@ namespace ft
     template<bool Cond, class T = void> struct enable_if {};
     template<class T> struct enable_if<true, T> { typedef T type; };
 
+    template <class T>
+    struct void_type { typedef void type; };
+
+    // enable_if_transparent<Compare, K, R>::type is R only when Compare declares
+    // is_transparent; K only makes the lookup depend on the caller's template
+    template <class Compare, class K, class R, class = void>
+    struct enable_if_transparent { };
+    template <class Compare, class K, class R>
+    struct enable_if_transparent<Compare, K, R, typename void_type<typename Compare::is_transparent>::type> { typedef R type; };
+
     template <bool is_integral, typename T>
     struct is_integral_res
     {
@@ -150,6 +164,40 @@ namespace ft
 
     class output_iterator_tag { };
 
+    // Concept tag, as in C++20: iterator_category stays random_access_iterator_tag
+    // and iterator_concept tells that the elements sit next to each other in memory
+    class contiguous_iterator_tag : public random_access_iterator_tag { };
+
+    template <class It, class = void>
+    struct is_contiguous_iterator { static const bool value = false; };
+
+    template <class T>
+    struct is_contiguous_iterator<T*, void> { static const bool value = true; };
+
+    template <class It>
+    struct is_contiguous_iterator<It, typename void_type<typename It::iterator_concept>::type>
+    {
+        static const bool value = std::is_same<typename It::iterator_concept, contiguous_iterator_tag>::value;
+    };
+
+    // Raw pointer behind a contiguous iterator, found by ADL for iterator classes
+    template <class T>
+    T* to_address(T* p) { return p; }
+
+    // Tag telling a container that a range is already sorted without duplicates
+    struct sorted_unique_t { };
+    static const sorted_unique_t sorted_unique = sorted_unique_t();
+
+    // Asks for the cache line holding p ahead of use; no-op without the builtin
+    inline void prefetch(const void* p)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(p);
+#else
+        (void)p;
+#endif
+    }
+
     template <bool is_valid, typename T>
         struct valid_iterator_tag_res { typedef T type; const static bool value = is_valid; };
     
@@ -220,7 +268,7 @@ namespace ft
         typedef ft::random_access_iterator_tag  iterator_category;
     };
     
-    template <class T> class iterator_traits<const T*>
+    template <class T> struct iterator_traits<const T*>
     {
         typedef ptrdiff_t                       difference_type;
         typedef T                               value_type;
@@ -229,9 +277,23 @@ namespace ft
         typedef ft::random_access_iterator_tag  iterator_category;
     };
 
-    template<class InputIterator>
+    // True when [first, last) can be walked more than once: forward iterators
+    // and better, with the ft:: or the std:: tags. A single-pass input
+    // iterator is used up by a first walk (counting, checking the order...)
+    template <class It>
+    struct is_multipass_iterator
+    {
+        typedef typename ft::iterator_traits<It>::iterator_category    category;
+
+        static const bool value = std::is_convertible<category, std::forward_iterator_tag>::value
+            || std::is_base_of<ft::forward_iterator_tag, category>::value
+            || std::is_base_of<ft::bidirectional_iterator_tag, category>::value
+            || std::is_base_of<ft::random_access_iterator_tag, category>::value;
+    };
+
+    template<class InputIterator, class Category>
         typename ft::iterator_traits<InputIterator>::difference_type
-            distance (InputIterator first, InputIterator last)
+            _distance (InputIterator first, InputIterator last, Category)
         {
             typename ft::iterator_traits<InputIterator>::difference_type rtn = 0;
             while (first != last)
@@ -242,6 +304,23 @@ namespace ft
             return (rtn);
         }
 
+    template<class RandomIterator>
+        typename ft::iterator_traits<RandomIterator>::difference_type
+            _distance (RandomIterator first, RandomIterator last, ft::random_access_iterator_tag)
+        { return (last - first); }
+
+    template<class RandomIterator>
+        typename ft::iterator_traits<RandomIterator>::difference_type
+            _distance (RandomIterator first, RandomIterator last, std::random_access_iterator_tag)
+        { return (last - first); }
+
+    template<class InputIterator>
+        typename ft::iterator_traits<InputIterator>::difference_type
+            distance (InputIterator first, InputIterator last)
+        {
+            return (ft::_distance(first, last, typename ft::iterator_traits<InputIterator>::iterator_category()));
+        }
+
     template <class Category, class T, class Distance = ptrdiff_t,
         class Pointer = T*, class Reference = T&>
         class iterator
@@ -266,9 +345,6 @@ namespace ft
                 // typedef typename ft::isConst<b, value_type&, const value_type&>::type reference;
                 // typedef typename ft::isConst<b, value_type*, const value_type*>::type pointer;
 
-            private:
-                // typedef typename ft::isConst<b, Node*, const Node*>::type nodePtr;
-                pointer _elem;
         };
 
     template <class Iterator>
@@ -299,8 +375,6 @@ namespace ft
                     _elem(rev_it.base())
                 {}
 
-            virtual ~reverse_iterator() {}
-
             iterator_type base() const
             { return (_elem); }
 
@@ -352,12 +426,24 @@ namespace ft
                 return (*this);
             }
 
-            pointer operator->() const { return &(operator*()); }
+            // Asks the base iterator, whose operator* may return a proxy by value
+            pointer operator->() const
+            {
+                iterator_type tmp(_elem);
+                --tmp;
+                return (_arrow(tmp));
+            }
 
             reference operator[](difference_type n) const { return (this->base()[-n - 1]); }
 
         private:
             iterator_type     _elem;
+
+            template <class It>
+                static pointer _arrow(const It& it) { return (it.operator->()); }
+
+            template <class T>
+                static pointer _arrow(T* p) { return (p); }
     };
 
     template <class Iterator>
@@ -422,7 +508,7 @@ namespace ft
                             return (rhs.base() - lhs.base()); }
 
     template <class InputIterator1, class InputIterator2>
-        bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+        bool _lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
                                         InputIterator2 first2, InputIterator2 last2)
         {
             while (first1 != last1)
@@ -435,6 +521,49 @@ namespace ft
             return (first2 != last2);
         }
 
+    template <class T1, class T2>
+        bool _lexicographical_compare_ptr(const T1* p1, std::size_t n1, const T2* p2, std::size_t n2, std::false_type)
+        {
+            return (ft::_lexicographical_compare(p1, p1 + n1, p2, p2 + n2));
+        }
+
+    template <class T>
+        bool _lexicographical_compare_ptr(const T* p1, std::size_t n1, const T* p2, std::size_t n2, std::true_type)
+        {
+            return (ft::less_bytes(p1, n1, p2, n2));
+        }
+
+    // Contiguous ranges are compared through raw pointers, and by the byte
+    // kernels when both hold the same integral type
+    template <class InputIterator1, class InputIterator2>
+        bool _lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                        InputIterator2 first2, InputIterator2 last2, std::true_type)
+        {
+            typedef typename std::remove_cv<typename ft::iterator_traits<InputIterator1>::value_type>::type    value_type1;
+            typedef typename std::remove_cv<typename ft::iterator_traits<InputIterator2>::value_type>::type    value_type2;
+
+            return (ft::_lexicographical_compare_ptr(to_address(first1), last1 - first1,
+                        to_address(first2), last2 - first2,
+                        std::integral_constant<bool, std::is_same<value_type1, value_type2>::value
+                            && ft::is_byte_comparable<value_type1>::value>()));
+        }
+
+    template <class InputIterator1, class InputIterator2>
+        bool _lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                        InputIterator2 first2, InputIterator2 last2, std::false_type)
+        {
+            return (ft::_lexicographical_compare(first1, last1, first2, last2));
+        }
+
+    template <class InputIterator1, class InputIterator2>
+        bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
+                                        InputIterator2 first2, InputIterator2 last2)
+        {
+            return (ft::_lexicographical_compare(first1, last1, first2, last2,
+                        std::integral_constant<bool, ft::is_contiguous_iterator<InputIterator1>::value
+                            && ft::is_contiguous_iterator<InputIterator2>::value>()));
+        }
+
     template <class InputIterator1, class InputIterator2, class Compare>
         bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1,
                                         InputIterator2 first2, InputIterator2 last2,
@@ -450,32 +579,84 @@ namespace ft
             return (first2 != last2);
         }
 
+	// Element-wise comparisons shared by the sequence containers
+	// (ft::vector, ft::small_vector, ft::deque)
+	template <class Seq>
+	bool _sequence_equal(const Seq& lhs, const Seq& rhs, std::false_type)
+	{
+		for (size_t i = 0; i < lhs.size(); i++)
+			if (lhs[i] != rhs[i]) return false;
+		return true;
+	}
+
+	template <class Seq>
+	bool _sequence_equal(const Seq& lhs, const Seq& rhs, std::true_type)
+	{
+		return (ft::equal_bytes(to_address(lhs.begin()), to_address(rhs.begin()), lhs.size()));
+	}
+
+	template <class Seq>
+	bool sequence_equal(const Seq& lhs, const Seq& rhs)
+	{
+		if (lhs.size() != rhs.size())
+			return (false);
+		return (ft::_sequence_equal(lhs, rhs,
+					std::integral_constant<bool, ft::is_contiguous_iterator<typename Seq::const_iterator>::value
+						&& ft::is_byte_comparable<typename Seq::value_type>::value>()));
+	}
+
+	template <class Seq>
+	bool sequence_less(const Seq& lhs, const Seq& rhs)
+	{
+		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+	}
+
+	// Reallocation hook used by ft::vector: disabled for ordinary allocators,
+	// specialised by mmap_allocator.hpp
+	template <class Alloc>
+	struct remap_traits
+	{
+		static const bool enabled = false;
+
+		static typename Alloc::pointer remap(Alloc&, typename Alloc::pointer, std::size_t, std::size_t)
+		{
+			return 0;
+		}
+	};
+
 	enum	colors
 	{
 		BLACK,
 		RED
 	};
 
+	// Colour and sentinel flags live in the low bits of parent:
+	// bit 0 colour, bit 1 isnull, bit 2 isrend
 	template <class Pair>
 	class node {
 
 	public:
-		node() : isnull(false)
+		node() : parent(0)
 		{
 		}
 
-        node(Pair val) : data(val), isnull(false) {}
+        node(Pair val) : data(val), parent(0) {}
 
 		~node()
 		{}
 
+		colors	color() const { return parent.tag_bit(0) ? RED : BLACK; }
+		void	set_color(colors c) { parent.set_tag_bit(0, c == RED); }
+		bool	isnull() const { return parent.tag_bit(1); }
+		void	set_isnull(bool b) { parent.set_tag_bit(1, b); }
+		bool	isrend() const { return parent.tag_bit(2); }
+		void	set_isrend(bool b) { parent.set_tag_bit(2, b); }
+
 		Pair	data;
-		node	*parent;
+		// three tag bits need 8-byte alignment, also on 32-bit targets
+		alignas(8) ft::tagged_ptr<node, 3>	parent;
 		node	*left;
 		node	*right;
-		colors	color;
-		bool	isnull;
-		bool	isrend;
 	};
 
 
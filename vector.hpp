@@ -3,6 +3,10 @@
 # include <memory>
 # include <algorithm>
 # include <cstddef>
+# include <cstring>
+# include <stdexcept>
+# include <type_traits>
+# include <utility>
 # include <tgmath.h>
 # include "./utils/utils.hpp"
 # include "./utils/random_access_iterator.hpp"
@@ -10,7 +14,29 @@
 
 namespace ft
 {
-	template < class T, class Alloc = std::allocator<T> >
+	// Growth policy for ft::vector: capacity is multiplied by Num / Den each
+	// time the buffer is full (always by at least one element)
+	template <std::size_t Num = 2, std::size_t Den = 1>
+	struct growth_factor
+	{
+		static std::size_t next(std::size_t capacity)
+		{
+			std::size_t grown = capacity / Den * Num + capacity % Den * Num / Den;
+			return grown > capacity ? grown : capacity + 1;
+		}
+	};
+
+	// Element properties that select the bulk-memory paths of ft::vector:
+	// bitwise types are copied, moved and shifted with memcpy / memmove,
+	// bytewise ones (char-sized integers) are also filled with memset
+	template <class T>
+	struct vector_traits
+	{
+		static const bool bitwise = std::is_trivially_copyable<T>::value;
+		static const bool bytewise = bitwise && sizeof(T) == 1 && ft::is_integral<T>::value;
+	};
+
+	template < class T, class Alloc = std::allocator<T>, class Growth = ft::growth_factor<> >
 	class vector
 	{   
 	public:
@@ -34,50 +60,79 @@ namespace ft
 		explicit vector(size_type n, const value_type& val = value_type(),
 				const allocator_type& alloc = allocator_type()) : _alloc(alloc), _size(n), _capacity(n)
 		{
-			_start = _alloc.allocate(n);
-			for (size_type i = 0; i < n; i++)
+			_start = n ? _alloc.allocate(n) : nullptr;
+			try
 			{
-				_alloc.construct(&_start[i], val);
+				this->_uninitialized_fill(_start, n, val);
+			}
+			catch (...)
+			{
+				_alloc.deallocate(_start, n);
+				throw;
 			}
 		}
 
 		template <class InputIterator>
 				vector (InputIterator first, InputIterator last,
 						const allocator_type& alloc = allocator_type(),
-						typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = nullptr) : _alloc(alloc)
+						typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = nullptr)
+				: _alloc(alloc), _start(nullptr), _size(0), _capacity(0)
 		{
-			difference_type n = ft::distance(first, last);
-
-			_size = n;
-			_capacity = n;
-			_start = _alloc.allocate(n);
-			for (difference_type i = 0; i < n; i++)
-			{
-				_alloc.construct(&_start[i], *(first++));
-			}
+			this->_range_init(first, last, std::integral_constant<bool, ft::is_multipass_iterator<InputIterator>::value>());
 		}
 		
-		vector (const vector& x) : _alloc(x.get_allocator()), _size(x._size), _capacity(x._capacity)
+		vector (const vector& x) : _alloc(x.get_allocator()), _start(nullptr), _size(0), _capacity(0)
 		{
-			T	*tmp;
+			if (x._size > 0) {
+				_start = _alloc.allocate(x._size);
+				try
+				{
+					this->_uninitialized_copy(_start, x._start, x._size);
+				}
+				catch (...)
+				{
+					_alloc.deallocate(_start, x._size);
+					throw;
+				}
+				_size = x._size;
+				_capacity = x._size;
+			}
+		}
 
-			if (_size > 0) {
-				_start = _alloc.allocate(_capacity);
-				tmp = _start;
-				for (size_t i = 0; i < _size; i++)
-					_alloc.construct(tmp++, x[i]);
-			} else {
-				_start = 0;
+		vector &operator=(const vector& x)
+		{
+			if (this == &x)
+				return *this;
+			if (x._size > _capacity)
+			{
+				vector tmp(x);
+				this->swap(tmp);
+				return *this;
 			}
+			//le buffer suffit : affecter sur les elements vivants, construire le reste
+			size_type common = _size < x._size ? _size : x._size;
+			this->_copy(_start, x._start, common);
+			if (x._size > _size)
+				this->_uninitialized_copy(_start + _size, x._start + _size, x._size - _size);
+			else
+				this->_destroy(_start + x._size, _size - x._size);
+			_size = x._size;
+			return *this;
+		}
 
+		vector (vector&& x) noexcept : _alloc(x._alloc), _start(x._start), _size(x._size), _capacity(x._capacity)
+		{
+			x._start = nullptr;
+			x._size = 0;
+			x._capacity = 0;
 		}
 
-		vector &operator=(const vector& x)
+		vector &operator=(vector&& x) noexcept
 		{
-			this->clear();
-			_alloc = x.get_allocator();
-			if (x._size > 0)
-				this->insert(this->end(), x.begin(), x.end());
+			if (this != &x)
+			{
+				vector(static_cast<vector&&>(x)).swap(*this);
+			}
 			return *this;
 		}
 
@@ -133,19 +188,47 @@ namespace ft
 		{
 			if (n > _size)
 			{
-				while (_size < n)
-				{
-					this->push_back(val);
-				}
+				if (n > _capacity)
+					this->_increase_capacity(n);
+				this->_uninitialized_fill(_start + _size, n - _size, val);
+				_size = n;
 			}
 			else
 			{
-				while (n < _size)
-				{
-					_alloc.destroy(&_start[n]);
-					_size--;
-				}
+				this->_destroy(_start + n, _size - n);
+				_size = n;
+			}
+		}
+
+		// Like resize(n) but new elements are default-initialised: for trivial
+		// types their memory is left untouched until it is first written
+		void        resize_default_init(size_type n)
+		{
+			if (n <= _size)
+			{
+				this->resize(n);
+				return ;
+			}
+			if (n > _capacity)
+				this->_increase_capacity(n);
+			if (std::is_trivially_default_constructible<T>::value)
+			{
+				_size = n;
+				return ;
 			}
+			for (; _size < n; _size++)
+				::new (static_cast<void*>(_start + _size)) T;
+		}
+
+		// Appends n elements built in place from successive gen() calls,
+		// with at most one reallocation
+		template <class Generator>
+		void        reserve_and_append(size_type n, Generator gen)
+		{
+			if (_size + n > _capacity)
+				this->_increase_capacity(_size + n);
+			for (size_type i = 0; i < n; i++, _size++)
+				this->_construct(_start + _size, gen());
 		}
 
 		size_type   capacity(void) const { return _capacity; }
@@ -154,10 +237,10 @@ namespace ft
 
 		void        reserve(size_type n)
 		{
+			if (n > this->max_size())
+				throw std::length_error("vector::reserve");
 			if (n > _capacity)
-			{
-				this->_increase_capacity();
-			}
+				this->_reallocate(n);
 		}
 
 		reference operator[](size_type n) { return _start[n]; }
@@ -214,10 +297,42 @@ namespace ft
 
 		void push_back(const value_type& val)
 		{
-			// this->insert(this->end(), val);
-			if (_size >= _capacity)
-				this->_increase_capacity();
-			_alloc.construct(_start + _size, val);
+			this->emplace_back(val);
+		}
+
+		void push_back(value_type&& val)
+		{
+			this->emplace_back(std::move(val));
+		}
+
+		template <class... Args>
+		void emplace_back(Args&&... args)
+		{
+			if (_size >= _capacity && _remaps)
+			{
+				// the buffer keeps its bytes but may move: args could point into it
+				value_type	tmp(std::forward<Args>(args)...);
+				this->_increase_capacity(_size + 1);
+				this->_construct(_start + _size, std::move(tmp));
+			}
+			else if (_size >= _capacity)
+			{
+				// args may refer to an element: build the new one before the old buffer goes
+				size_type	new_capacity = this->_recommend(_size + 1);
+				pointer		new_start = _alloc.allocate(new_capacity);
+				try
+				{
+					this->_construct(new_start + _size, std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					_alloc.deallocate(new_start, new_capacity);
+					throw;
+				}
+				this->_adopt(new_start, new_capacity, _size, 1);
+			}
+			else
+				this->_construct(_start + _size, std::forward<Args>(args)...);
 			_size++;
 		}
 
@@ -232,46 +347,82 @@ namespace ft
 
 		iterator insert(iterator position, const value_type& val)
 		{
-			size_type	diff;
-			iterator	it;
-			size_type	i;
+			return this->emplace(position, val);
+		}
+
+		iterator insert(iterator position, value_type&& val)
+		{
+			return this->emplace(position, std::move(val));
+		}
 
-			diff = this->end() - position;
+		template <class... Args>
+		iterator emplace(iterator position, Args&&... args)
+		{
+			size_type	idx = position - this->begin();
+
+			if (idx == _size)
+			{
+				this->emplace_back(std::forward<Args>(args)...);
+				return this->end() - 1;
+			}
+			// args may refer to an element: build the value before anything moves
+			value_type	tmp(std::forward<Args>(args)...);
+			if (_size >= _capacity && _remaps)
+				this->_increase_capacity(_size + 1);
 			if (_size >= _capacity)
-				this->_increase_capacity();
-			it = this->end();
-			i = 0;
-			while (i < diff)
 			{
-				*it = *(it - 1);
-				i++;
-				it--;
+				size_type	new_capacity = this->_recommend(_size + 1);
+				pointer		new_start = _alloc.allocate(new_capacity);
+				try
+				{
+					this->_construct(new_start + idx, std::move(tmp));
+				}
+				catch (...)
+				{
+					_alloc.deallocate(new_start, new_capacity);
+					throw;
+				}
+				this->_adopt(new_start, new_capacity, idx, 1);
+				_size++;
+				return this->begin() + idx;
 			}
-			*it = val;
-			_size++;
-			return it;
+			this->_open_slot(_start, idx);
+			_start[idx] = std::move(tmp);
+			return this->begin() + idx;
 		}
 
 		void insert(iterator position, size_type n, const value_type& val)
 		{
-			size_type	diff;
-			iterator	it;
+			size_type	idx = position - this->begin();
 
-			diff = abs(this->end() - position);
-			while (_size + n > _capacity)
-				this->_increase_capacity();
-			it = (this->end() + n - 1);
-			while (diff--)
-			{
-				*it = *(it - n);
-				it--;
-			}
-			_size += n;
-			while (n--)
+			if (!n)
+				return ;
+			// val may live in the buffer: copy it before anything moves
+			value_type	tmp(val);
+			if (_size + n > _capacity && _remaps)
+				this->_increase_capacity(_size + n);
+			if (_size + n > _capacity)
 			{
-				*it = val;
-				it--;
+				size_type	new_capacity = this->_recommend(_size + n);
+				pointer		new_start = _alloc.allocate(new_capacity);
+				size_type	i = 0;
+				try
+				{
+					for (; i < n; i++)
+						_alloc.construct(new_start + idx + i, tmp);
+				}
+				catch (...)
+				{
+					while (i--)
+						_alloc.destroy(new_start + idx + i);
+					_alloc.deallocate(new_start, new_capacity);
+					throw;
+				}
+				this->_adopt(new_start, new_capacity, idx, n);
+				_size += n;
+				return ;
 			}
+			this->_insert_in_place(_start, idx, n, tmp);
 		}
 
 		// template <class InputIterator>
@@ -305,92 +456,27 @@ namespace ft
 		// }
 
 		template <class InputIterator>
-		void insert(iterator position, InputIterator first, InputIterator last, typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = 0) {
-			InputIterator tmp = first;
-			difference_type n = 0;
-			while (tmp != last)
-			{
-				n++;
-				tmp++;
-			}
-
-			size_t new_capacity = _capacity;
-			while (_size + n > new_capacity)
-				new_capacity = 2 * new_capacity + (new_capacity == 0);
-			T* new_start = _alloc.allocate(new_capacity);
-
-
-			size_t i = 0;
-			while (begin() + i != position)
-			{
-				_alloc.construct(new_start + i, _start[i]);
-				i++;
-			}
-
-			difference_type j = 0;
-			try 
-			{
-				while (j < n)
-				{
-					_alloc.construct(new_start + i + j, *first++);
-					j++;
-				}
-			}
-			catch(...)
-			{
-				size_t l = 0;
-				while (l < i + j)
-				{
-					_alloc.destroy(new_start + l);
-					l++;
-				}
-				_alloc.deallocate(new_start, new_capacity);
-				throw;
-			}
-			
-			while (i < _size)
-			{
-				_alloc.construct(new_start + i + n, _start[i]);
-				i++;
-			}
-
-			for (i = 0; i < _size; i++)
-				_alloc.destroy(_start + i);
-			_alloc.deallocate(_start, _capacity);
-			
-			_start = new_start;
-			_capacity = new_capacity;
-			_size += n;
+		void insert(iterator position, InputIterator first, InputIterator last,
+			typename ft::enable_if<!ft::is_integral<InputIterator>::value, InputIterator>::type* = nullptr)
+		{
+			this->_insert_range(position - this->begin(), first, last,
+				std::integral_constant<bool, ft::is_multipass_iterator<InputIterator>::value>());
 		}
 
 		iterator erase(iterator position)
 		{
-			if (_size)
-			{
-				_alloc.destroy(&(*position));
-				for (iterator it = position; it != this->end(); it++)
-				{
-					*it = *(it + 1);
-				}
-				_size--;
-			}
-			return position;
+			return this->erase(position, position + 1);
 		}
 
 		iterator erase(iterator first, iterator last)
 		{
 			difference_type diff = last - first;
 
-			if (_size)
+			if (diff > 0)
 			{
-				for (iterator it = first; it != last; it++)
-				{
-					_alloc.destroy(&(*it));
-				}
-				for (iterator it = first; it != this->end() - diff; it++)
-				{
-					*it = *(it + diff);
-				}
+				pointer	dst = first.base();
+				this->_shift_down(dst, dst + diff, this->end().base() - dst - diff);
+				this->_destroy(this->end().base() - diff, diff);
 				_size -= diff;
 			}
 			return first;
@@ -437,88 +523,424 @@ namespace ft
 		size_type		_size;
 		size_type		_capacity;
 
-		void	_increase_capacity()
+		// Single-pass input cannot be counted first: it is read once, growing as it goes
+		template <class InputIterator>
+		void	_range_init(InputIterator first, InputIterator last, std::false_type)
+		{
+			try
+			{
+				for (; first != last; ++first)
+					this->push_back(*first);
+			}
+			catch (...)
+			{
+				this->_destroy(_start, _size);
+				if (_start)
+					_alloc.deallocate(_start, _capacity);
+				throw;
+			}
+		}
+
+		template <class ForwardIterator>
+		void	_range_init(ForwardIterator first, ForwardIterator last, std::true_type)
+		{
+			size_type	n = ft::distance(first, last);
+
+			_start = n ? _alloc.allocate(n) : nullptr;
+			_capacity = n;
+			try
+			{
+				for (; _size < n; ++_size, ++first)
+					this->_construct(_start + _size, *first);
+			}
+			catch (...)
+			{
+				this->_destroy(_start, _size);
+				_alloc.deallocate(_start, n);
+				throw;
+			}
+		}
+
+		// Capacity for at least `needed` elements following the growth policy
+		size_type	_recommend(size_type needed) const
+		{
+			size_type	max = this->max_size();
+
+			if (needed > max)
+				throw std::length_error("vector: capacity error");
+			size_type	grown = _capacity < max / 2 ? Growth::next(_capacity) : max;
+			if (grown > max)
+				grown = max;
+			return grown > needed ? grown : needed;
+		}
+
+		void	_increase_capacity(size_type needed)
+		{
+			this->_reallocate(this->_recommend(needed));
+		}
+
+		// Bulk kernels: each comes as a bitwise overload and an element-wise one,
+		// picked by vector_traits on the element type.
+
+		// Builds n elements at raw storage dst from those of src, which are left
+		// for the caller to destroy: moved when that cannot throw, copied otherwise.
+		// On failure nothing is left constructed at dst.
+		template <class U>
+		typename ft::enable_if<vector_traits<U>::bitwise>::type	_transfer(U* dst, U* src, size_type n)
+		{
+			if (n)
+				std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(U));
+		}
+
+		template <class U>
+		typename ft::enable_if<!vector_traits<U>::bitwise>::type	_transfer(U* dst, U* src, size_type n)
+		{
+			size_type i = 0;
+			try
+			{
+				for (; i < n; i++)
+					this->_construct(dst + i, std::move_if_noexcept(src[i]));
+			}
+			catch (...)
+			{
+				while (i--)
+					_alloc.destroy(dst + i);
+				throw;
+			}
+		}
+
+		template <class U>
+		typename ft::enable_if<vector_traits<U>::bitwise>::type	_uninitialized_copy(U* dst, const U* src, size_type n)
+		{
+			if (n)
+				std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(U));
+		}
+
+		template <class U>
+		typename ft::enable_if<!vector_traits<U>::bitwise>::type	_uninitialized_copy(U* dst, const U* src, size_type n)
+		{
+			size_type i = 0;
+			try
+			{
+				for (; i < n; i++)
+					this->_construct(dst + i, src[i]);
+			}
+			catch (...)
+			{
+				while (i--)
+					_alloc.destroy(dst + i);
+				throw;
+			}
+		}
+
+		// Assigns n live elements from a non overlapping range
+		template <class U>
+		typename ft::enable_if<vector_traits<U>::bitwise>::type	_copy(U* dst, const U* src, size_type n)
+		{
+			if (n)
+				std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(U));
+		}
+
+		template <class U>
+		typename ft::enable_if<!vector_traits<U>::bitwise>::type	_copy(U* dst, const U* src, size_type n)
+		{
+			std::copy(src, src + n, dst);
+		}
+
+		// Builds n copies of val at raw storage p; on failure nothing is left constructed
+		template <class U>
+		typename ft::enable_if<vector_traits<U>::bitwise>::type	_uninitialized_fill(U* p, size_type n, const U& val)
+		{
+			this->_fill(p, n, val);
+		}
+
+		template <class U>
+		typename ft::enable_if<!vector_traits<U>::bitwise>::type	_uninitialized_fill(U* p, size_type n, const U& val)
 		{
-			if (!_capacity)
+			size_type i = 0;
+			try
 			{
-				_start = _alloc.allocate(1);
-				_capacity = 1;
+				for (; i < n; i++)
+					this->_construct(p + i, val);
 			}
-			else if (_capacity < this->max_size() / 2)
+			catch (...)
 			{
-				pointer tmp = _alloc.allocate(_capacity * 2);
+				while (i--)
+					_alloc.destroy(p + i);
+				throw;
+			}
+		}
+
+		// Moves n live elements down to dst < src (erase)
+		template <class U>
+		typename ft::enable_if<vector_traits<U>::bitwise>::type	_shift_down(U* dst, U* src, size_type n)
+		{
+			if (n)
+				std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), n * sizeof(U));
+		}
+
+		template <class U>
+		typename ft::enable_if<!vector_traits<U>::bitwise>::type	_shift_down(U* dst, U* src, size_type n)
+		{
+			std::move(src, src + n, dst);
+		}
+
+		template <class U>
+		typename ft::enable_if<vector_traits<U>::bytewise>::type	_fill(U* p, size_type n, const U& val)
+		{
+			if (n)
+				std::memset(static_cast<void*>(p), static_cast<unsigned char>(val), n);
+		}
+
+		template <class U>
+		typename ft::enable_if<!vector_traits<U>::bytewise>::type	_fill(U* p, size_type n, const U& val)
+		{
+			std::fill(p, p + n, val);
+		}
+
+		// Moves [idx, _size) up by one inside the buffer, which has room;
+		// slot idx is left live for the caller to assign
+		template <class U>
+		typename ft::enable_if<vector_traits<U>::bitwise>::type	_open_slot(U* start, size_type idx)
+		{
+			std::memmove(static_cast<void*>(start + idx + 1), static_cast<const void*>(start + idx), (_size - idx) * sizeof(U));
+			_size++;
+		}
+
+		template <class U>
+		typename ft::enable_if<!vector_traits<U>::bitwise>::type	_open_slot(U* start, size_type idx)
+		{
+			this->_construct(start + _size, std::move(start[_size - 1]));
+			_size++;
+			std::move_backward(start + idx, start + _size - 2, start + _size - 1);
+		}
+
+		// Inserts n copies of val at idx inside the buffer, which has room;
+		// val must not refer to an element
+		template <class U>
+		typename ft::enable_if<vector_traits<U>::bitwise>::type	_insert_in_place(U* start, size_type idx, size_type n, const U& val)
+		{
+			std::memmove(static_cast<void*>(start + idx + n), static_cast<const void*>(start + idx), (_size - idx) * sizeof(U));
+			this->_fill(start + idx, n, val);
+			_size += n;
+		}
 
-				size_type i = 0;
-				for (iterator it = this->begin(); it != this->end(); it++, i++)
+		template <class U>
+		typename ft::enable_if<!vector_traits<U>::bitwise>::type	_insert_in_place(U* start, size_type idx, size_type n, const U& val)
+		{
+			size_type	old_size = _size;
+			size_type	after = old_size - idx;
+
+			//les cases au-dela de _size sont brutes : construire, ne pas affecter
+			if (after > n)
+			{
+				for (size_type i = old_size - n; i < old_size; i++, _size++)
+					this->_construct(start + i + n, std::move(start[i]));
+				std::move_backward(start + idx, start + old_size - n, start + old_size);
+				this->_fill(start + idx, n, val);
+			}
+			else
+			{
+				for (size_type i = 0; i < n - after; i++, _size++)
+					this->_construct(start + old_size + i, val);
+				for (size_type i = idx; i < old_size; i++, _size++)
+					this->_construct(start + i + n, std::move(start[i]));
+				this->_fill(start + idx, after, val);
+			}
+		}
+
+		// Inserts the n elements of [first, ...) at idx inside the buffer, which has room
+		template <class ForwardIterator, class U>
+		typename ft::enable_if<vector_traits<U>::bitwise>::type	_insert_range_in_place(U* start, size_type idx, ForwardIterator first, size_type n)
+		{
+			std::memmove(static_cast<void*>(start + idx + n), static_cast<const void*>(start + idx), (_size - idx) * sizeof(U));
+			try
+			{
+				for (size_type i = 0; i < n; i++, ++first)
+					start[idx + i] = *first;
+			}
+			catch (...)
+			{
+				std::memmove(static_cast<void*>(start + idx), static_cast<const void*>(start + idx + n), (_size - idx) * sizeof(U));
+				throw;
+			}
+			_size += n;
+		}
+
+		template <class ForwardIterator, class U>
+		typename ft::enable_if<!vector_traits<U>::bitwise>::type	_insert_range_in_place(U* start, size_type idx, ForwardIterator first, size_type n)
+		{
+			size_type	old_size = _size;
+			size_type	after = old_size - idx;
+
+			//meme partage que _insert_in_place : construire au-dela de _size, affecter en deca
+			if (after > n)
+			{
+				for (size_type i = old_size - n; i < old_size; i++, _size++)
+					this->_construct(start + i + n, std::move(start[i]));
+				std::move_backward(start + idx, start + old_size - n, start + old_size);
+				for (size_type i = 0; i < n; i++, ++first)
+					start[idx + i] = *first;
+			}
+			else
+			{
+				ForwardIterator	mid = first;
+				for (size_type i = 0; i < after; i++)
+					++mid;
+				for (size_type i = 0; i < n - after; i++, _size++, ++mid)
+					this->_construct(start + old_size + i, *mid);
+				for (size_type i = idx; i < old_size; i++, _size++)
+					this->_construct(start + i + n, std::move(start[i]));
+				for (size_type i = 0; i < after; i++, ++first)
+					start[idx + i] = *first;
+			}
+		}
+
+		// Single-pass input cannot be counted: staged first, then moved in
+		template <class InputIterator>
+		void	_insert_range(size_type idx, InputIterator first, InputIterator last, std::false_type)
+		{
+			vector	tmp(first, last, _alloc);
+
+			this->_insert_range(idx, std::make_move_iterator(tmp._start), std::make_move_iterator(tmp._start + tmp._size),
+				std::true_type());
+		}
+
+		template <class ForwardIterator>
+		void	_insert_range(size_type idx, ForwardIterator first, ForwardIterator last, std::true_type)
+		{
+			size_type	n = ft::distance(first, last);
+
+			if (!n)
+				return ;
+			if (_size + n > _capacity && _remaps)
+				this->_increase_capacity(_size + n);
+			if (_size + n > _capacity)
+			{
+				size_type	new_capacity = this->_recommend(_size + n);
+				pointer		new_start = _alloc.allocate(new_capacity);
+				size_type	i = 0;
+				try
 				{
-					_alloc.construct((tmp + i), *it);
+					for (; i < n; i++, ++first)
+						this->_construct(new_start + idx + i, *first);
 				}
-				pointer tmp2 = _start;
-				for (size_t i = 0; i < _size; i++)
-						_alloc.destroy(tmp2++);
-				_alloc.deallocate(_start, _capacity);
-				_start = tmp;
-				_capacity *= 2;
+				catch (...)
+				{
+					while (i--)
+						_alloc.destroy(new_start + idx + i);
+					_alloc.deallocate(new_start, new_capacity);
+					throw;
+				}
+				this->_adopt(new_start, new_capacity, idx, n);
+				_size += n;
+				return ;
 			}
-			else
+			this->_insert_range_in_place(_start, idx, first, n);
+		}
+
+		void	_destroy(pointer p, size_type n)
+		{
+			if (vector_traits<T>::bitwise)
+				return ;
+			for (size_type i = 0; i < n; i++)
+				_alloc.destroy(p + i);
+		}
+
+		template <class... Args>
+		void	_construct(pointer p, Args&&... args)
+		{
+			std::allocator_traits<allocator_type>::construct(_alloc, p, std::forward<Args>(args)...);
+		}
+
+		// Switches to new_start, whose [idx, idx + gap) is already built: the
+		// current elements are transferred around the gap. If that throws, the
+		// gap is destroyed and the vector keeps its old buffer.
+		void	_adopt(pointer new_start, size_type new_capacity, size_type idx, size_type gap)
+		{
+			try
 			{
-				throw std::runtime_error("capacity error");
+				this->_transfer(new_start, _start, idx);
+				try
+				{
+					this->_transfer(new_start + idx + gap, _start + idx, _size - idx);
+				}
+				catch (...)
+				{
+					this->_destroy(new_start, idx);
+					throw;
+				}
 			}
+			catch (...)
+			{
+				this->_destroy(new_start + idx, gap);
+				_alloc.deallocate(new_start, new_capacity);
+				throw;
+			}
+			this->_destroy(_start, _size);
+			if (_capacity)
+				_alloc.deallocate(_start, _capacity);
+			_start = new_start;
+			_capacity = new_capacity;
+		}
+
+		// Bitwise elements in a buffer the allocator can remap in place of a copy
+		static const bool _remaps = vector_traits<T>::bitwise && remap_traits<allocator_type>::enabled;
+
+		void	_reallocate(size_type new_capacity)
+		{
+			if (_remaps && _capacity)
+			{
+				pointer p = remap_traits<allocator_type>::remap(_alloc, _start, _capacity, new_capacity);
+				if (p)
+				{
+					_start = p;
+					_capacity = new_capacity;
+					return ;
+				}
+			}
+			this->_adopt(_alloc.allocate(new_capacity), new_capacity, _size, 0);
 		}
 	};
 
-	template <class T, class Alloc>
-	bool operator==(const ft::vector<T, Alloc>& lhs, const ft::vector<T, Alloc>& rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator==(const ft::vector<T, Alloc, Growth>& lhs, const ft::vector<T, Alloc, Growth>& rhs)
 	{
-		if (lhs.size() != rhs.size())
-			return (false);
-		for (size_t i = 0; i < lhs.size(); i++)
-			if (lhs[i] != rhs[i]) return false;
-		return true;
-		// typename ft::vector<T>::const_iterator first1 = lhs.begin();
-		// typename ft::vector<T>::const_iterator first2 = rhs.begin();
-		// while (first1 != lhs.end())
-		// {
-		// 	if (first2 == rhs.end() || *first1 != *first2)
-		// 		return (false);
-		// 	++first1;
-		// 	++first2;
-		// }
-		// return (true);
+		return (ft::sequence_equal(lhs, rhs));
 	}
 
-	template <class T, class Alloc>
-	bool operator!=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator!=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return (!(lhs == rhs));
 	}
 	
-	template <class T, class Alloc>
-	bool operator<(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator<(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
-		return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+		return (ft::sequence_less(lhs, rhs));
 	}
 
-	template <class T, class Alloc>
-	bool operator<=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator<=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return (!(rhs < lhs));
 	}
 
-	template <class T, class Alloc>
-	bool operator>(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator>(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return (rhs < lhs);
 	}
 
-	template <class T, class Alloc>
-	bool operator>=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
+	template <class T, class Alloc, class Growth>
+	bool operator>=(const vector<T, Alloc, Growth>& lhs, const vector<T, Alloc, Growth>& rhs)
 	{
 		return (!(lhs < rhs));
 	}
 	
-	template <class T, class Alloc>
-	void swap(vector<T,Alloc>& x, vector<T,Alloc>&y)
+	template <class T, class Alloc, class Growth>
+	void swap(vector<T,Alloc,Growth>& x, vector<T,Alloc,Growth>&y)
 	{
 		x.swap(y);
 	}